@@ -0,0 +1,184 @@
+// BroadphaseBench.cpp
+//
+// Compares the SpatialHash broadphase against the old linear scan for
+// projectile-vs-entity collision as the entity count grows. First checks that
+// the batched AABB test agrees with the scalar predicate box for box, and exits
+// with status 1 on any mismatch.
+//
+// Build from Part4/Assignment:
+//   g++ -std=c++20 -O2 -Iinclude bench/BroadphaseBench.cpp src/SpatialHash.cpp src/AabbBatch.cpp `pkg-config --cflags --libs sdl2` -o broadphase_bench
+#include "../include/SpatialHash.hpp"
+#include "../include/AabbBatch.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Same predicate as GameEntity::TestCollision.
+bool Overlaps(const SDL_FRect& a, const SDL_FRect& b) {
+    return !(b.x + b.w <= a.x ||
+             a.x + a.w <= b.x ||
+             b.y + b.h <= a.y ||
+             a.y + a.h <= b.y);
+}
+
+// Random boxes on a coarse grid so edges often touch exactly, plus zero-size boxes
+// and NaN fields, each tested as a packed box and as the query
+bool CheckAabbBatch() {
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    std::mt19937 rng(99);
+    std::uniform_int_distribution<int> cell(0, 20);
+    std::uniform_int_distribution<int> size(0, 6);
+    std::uniform_int_distribution<int> kind(0, 15);
+
+    auto makeBox = [&] {
+        SDL_FRect rect = {cell(rng) * 10.0f, cell(rng) * 10.0f, size(rng) * 10.0f, size(rng) * 10.0f};
+        switch (kind(rng)) {
+            case 0: rect.x = nan; break;
+            case 1: rect.y = nan; break;
+            case 2: rect.w = nan; break;
+            case 3: rect.h = nan; break;
+            case 4: rect.w = 0.0f; rect.h = 0.0f; break;
+            case 5: rect.x += 0.5f; rect.w = 3.25f; break;
+            default: break;
+        }
+        return rect;
+    };
+
+    // An odd count leaves a tail after the 8- and 4-wide steps
+    constexpr std::size_t BoxCount = 5003;
+    AabbSoA boxes;
+    std::vector<SDL_FRect> rects;
+    for (std::size_t i = 0; i < BoxCount; ++i) {
+        rects.push_back(makeBox());
+        boxes.Push(rects.back());
+    }
+
+    std::vector<std::uint32_t> hits;
+    std::vector<std::uint64_t> mask((BoxCount + 63) / 64);
+    long checked = 0;
+    for (int query = 0; query < 2000; ++query) {
+        const SDL_FRect shot = makeBox();
+
+        hits.clear();
+        IntersectAabbBatch(shot, boxes, hits);
+        std::size_t next = 0;
+        for (std::uint32_t i = 0; i < BoxCount; ++i) {
+            const bool expected = Overlaps(shot, rects[i]);
+            const bool found = next < hits.size() && hits[next] == i;
+            if (found) ++next;
+            if (expected != found) {
+                std::fprintf(stderr, "AABB batch mismatch: query %d, box %u (scalar %d, batch %d)\n",
+                             query, i, expected, found);
+                return false;
+            }
+        }
+
+        // Unaligned start, so the vector loads don't only ever see aligned data
+        const std::size_t offset = query % 7;
+        IntersectAabbMask(shot, boxes.x.data() + offset, boxes.y.data() + offset, boxes.w.data() + offset,
+                          boxes.h.data() + offset, BoxCount - offset, mask.data());
+        for (std::size_t i = 0; i < BoxCount - offset; ++i) {
+            const bool expected = Overlaps(shot, rects[i + offset]);
+            const bool found = (mask[i / 64] >> (i % 64)) & 1;
+            if (expected != found) {
+                std::fprintf(stderr, "AABB mask mismatch: query %d, box %zu (scalar %d, mask %d)\n",
+                             query, i + offset, expected, found);
+                return false;
+            }
+        }
+        checked += BoxCount;
+    }
+    std::printf("AABB batch matched the scalar test on %ld box pairs\n", checked);
+    return true;
+}
+
+using Clock = std::chrono::steady_clock;
+
+double Millis(Clock::duration d) {
+    return std::chrono::duration<double, std::milli>(d).count();
+}
+
+} // namespace
+
+int main() {
+    if (!CheckAabbBatch()) return 1;
+
+    const int entityCounts[] = {1000, 5000, 10000, 25000, 50000};
+    const int projectileCount = 256;
+    const int frames = 60;
+
+    std::printf("%8s %6s %12s %12s %14s %14s %10s\n",
+                "entities", "shots", "rebuild ms", "query ms", "grid frame ms", "linear frame ms", "hits");
+
+    for (int entityCount : entityCounts) {
+        // Keep density constant (one 40x40 enemy per 60x60 area, like the invader grid)
+        // so the world grows with the entity count.
+        const float worldSize = std::sqrt(static_cast<float>(entityCount)) * 60.0f;
+
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> pos(0.0f, worldSize);
+        std::uniform_real_distribution<float> jitter(-2.0f, 2.0f);
+
+        std::vector<SDL_FRect> entities(entityCount);
+        for (auto& rect : entities) rect = {pos(rng), pos(rng), 40.0f, 40.0f};
+
+        std::vector<SDL_FRect> projectiles(projectileCount);
+        for (auto& rect : projectiles) rect = {pos(rng), pos(rng), 6.0f, 20.0f};
+
+        SpatialHash grid(64.0f);
+        std::vector<std::uint32_t> candidates;
+
+        Clock::duration rebuild{}, query{}, linear{};
+        long gridHits = 0, linearHits = 0;
+
+        for (int frame = 0; frame < frames; ++frame) {
+            for (auto& rect : entities) {
+                rect.x += jitter(rng);
+                rect.y += jitter(rng);
+            }
+
+            auto t0 = Clock::now();
+            grid.Clear();
+            for (std::uint32_t i = 0; i < entities.size(); ++i) {
+                grid.Insert(i, entities[i]);
+            }
+            grid.Build();
+            auto t1 = Clock::now();
+            for (const auto& shot : projectiles) {
+                candidates.clear();
+                grid.Query(shot, candidates);
+                for (std::uint32_t i : candidates) {
+                    if (Overlaps(shot, entities[i])) ++gridHits;
+                }
+            }
+            auto t2 = Clock::now();
+            for (const auto& shot : projectiles) {
+                for (const auto& rect : entities) {
+                    if (Overlaps(shot, rect)) ++linearHits;
+                }
+            }
+            auto t3 = Clock::now();
+
+            rebuild += t1 - t0;
+            query += t2 - t1;
+            linear += t3 - t2;
+        }
+
+        if (gridHits != linearHits) {
+            std::fprintf(stderr, "mismatch at %d entities: grid %ld, linear %ld\n", entityCount, gridHits, linearHits);
+            return 1;
+        }
+
+        std::printf("%8d %6d %12.4f %12.4f %14.4f %14.4f %10ld\n",
+                    entityCount, projectileCount,
+                    Millis(rebuild) / frames, Millis(query) / frames,
+                    Millis(rebuild + query) / frames, Millis(linear) / frames,
+                    gridHits);
+    }
+    return 0;
+}
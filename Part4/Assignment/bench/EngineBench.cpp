@@ -0,0 +1,237 @@
+// EngineBench.cpp
+//
+// Microbenchmarks for the engine paths the game leans on every frame: component
+// add/get, collision tests, transform moves, enemy and projectile updates, and
+// texture cache hits/misses. Each benchmark runs at several entity counts and
+// reports ns/op and heap allocations/op as a table on stdout, and as JSON when
+// given a path to write it to.
+//
+// Build and run from Part4/Assignment (the texture benchmarks read Assets/):
+//   g++ -std=c++20 -O2 -DNDEBUG -Iinclude bench/EngineBench.cpp $(ls src/*.cpp | grep -v main.cpp) `pkg-config --cflags --libs sdl2` -pthread -o engine_bench
+//   ./engine_bench [results.json]   (keep results out of the source tree)
+#include "../include/GameEntity.hpp"
+#include "../include/Enemy.hpp"
+#include "../include/ProjectilePool.hpp"
+#include "../include/ResourceManager.hpp"
+#include "../include/Log.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+// Count every heap allocation in the process so benchmarks can report allocations/op.
+namespace {
+std::atomic<std::uint64_t> sAllocations{0};
+}
+
+void* operator new(std::size_t size) {
+    sAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Result {
+    std::string name;
+    int count;
+    double nsPerOp;
+    double allocsPerOp;
+};
+
+// Runs `body` (which performs `ops` operations) repeatedly until about 50 ms of
+// it has been timed. `reset` runs before each repetition and isn't timed.
+Result Measure(const std::string& name, int count, std::size_t ops,
+               const std::function<void()>& body, const std::function<void()>& reset = [] {},
+               int maxRepetitions = 1000) {
+    Clock::duration timed{};
+    std::uint64_t allocations = 0;
+    std::size_t totalOps = 0;
+
+    for (int rep = 0; rep < maxRepetitions && timed < std::chrono::milliseconds(50); ++rep) {
+        reset();
+        std::uint64_t allocationsBefore = sAllocations.load(std::memory_order_relaxed);
+        Clock::time_point start = Clock::now();
+        body();
+        timed += Clock::now() - start;
+        allocations += sAllocations.load(std::memory_order_relaxed) - allocationsBefore;
+        totalOps += ops;
+    }
+
+    double ns = std::chrono::duration<double, std::nano>(timed).count();
+    return {name, count, ns / totalOps, static_cast<double>(allocations) / totalOps};
+}
+
+// Keeps the optimizer from throwing away a benchmark's result.
+volatile float sSink;
+
+std::vector<std::unique_ptr<GameEntity>> MakeEntities(int count) {
+    std::vector<std::unique_ptr<GameEntity>> entities;
+    entities.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        auto entity = std::make_unique<GameEntity>();
+        TransformComponent transform;
+        transform.SetX(static_cast<float>(i % 800));
+        transform.SetY(static_cast<float>(i % 600));
+        entity->AddComponent(transform);
+        entity->AddComponent(Collision2DComponent());
+        entity->InitializeComponents();
+        entities.push_back(std::move(entity));
+    }
+    return entities;
+}
+
+void BenchComponents(int count, std::vector<Result>& results) {
+    // Adding components moves the entity between archetypes, so this also
+    // covers archetype lookup and row migration, plus freeing the entities again.
+    results.push_back(Measure("GameEntity::AddComponent", count, static_cast<std::size_t>(count) * 2, [&] {
+        std::vector<std::unique_ptr<GameEntity>> entities;
+        entities.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            auto entity = std::make_unique<GameEntity>();
+            entity->AddComponent(TransformComponent());
+            entity->AddComponent(Collision2DComponent());
+            entities.push_back(std::move(entity));
+        }
+    }, [] {}, 5));
+
+    auto entities = MakeEntities(count);
+    results.push_back(Measure("GameEntity::GetComponent", count, count, [&] {
+        float sum = 0.0f;
+        for (auto& entity : entities) {
+            sum += entity->GetComponent<TransformComponent>().GetX();
+        }
+        sSink = sum;
+    }));
+
+    results.push_back(Measure("GameEntity::TestCollision", count, count, [&] {
+        int hits = 0;
+        for (std::size_t i = 0; i < entities.size(); ++i) {
+            hits += entities[i]->TestCollision(*entities[(i + 1) % entities.size()]);
+        }
+        sSink = static_cast<float>(hits);
+    }));
+
+    results.push_back(Measure("TransformComponent::Move", count, count, [&] {
+        for (auto& entity : entities) {
+            entity->GetTransform().Move(0.5f, -0.5f);
+        }
+    }));
+}
+
+void BenchEnemies(int count, std::vector<Result>& results) {
+    const float step = 1.0f / 120.0f;
+    ProjectilePool pool(65536);
+    std::vector<std::unique_ptr<Enemy>> enemies;
+    for (int i = 0; i < count; ++i) {
+        auto enemy = std::make_unique<Enemy>(pool, static_cast<std::uint32_t>(i));
+        enemy->InitializeComponents();
+        enemies.push_back(std::move(enemy));
+    }
+
+    // Advance the pool's clock so enemies fire on schedule, and keep it from filling up
+    auto reset = [&] {
+        pool.FlushLaunches();
+        pool.Update(step);
+        while (pool.Size() > 0) pool.Despawn(pool.Size() - 1);
+    };
+    results.push_back(Measure("Enemy::Update", count, count, [&] {
+        for (auto& enemy : enemies) {
+            enemy->Update(step);
+        }
+    }, reset));
+}
+
+void BenchProjectiles(int count, std::vector<Result>& results) {
+    ProjectilePool pool(count);
+    auto reset = [&] {
+        while (pool.Size() > 0) pool.Despawn(pool.Size() - 1);
+        for (int i = 0; i < count; ++i) {
+            pool.Spawn(static_cast<float>(i % 800), 300.0f, 0.0f, (i & 1) ? 200.0f : -200.0f, 0, ProjectileTeam::Enemy);
+        }
+    };
+    results.push_back(Measure("ProjectilePool::Update", count, count, [&] {
+        pool.Update(1.0f / 120.0f);
+    }, reset));
+}
+
+void BenchTextureHit(SDL_Renderer* renderer, int count, std::vector<Result>& results) {
+    ResourceManager& resources = ResourceManager::Instance();
+    const std::string path = "Assets/Alien.bmp";
+
+    resources.LoadTexture(renderer, path);
+    results.push_back(Measure("ResourceManager::LoadTexture (hit)", count, count, [&] {
+        for (int i = 0; i < count; ++i) {
+            sSink = resources.LoadTexture(renderer, path) ? 1.0f : 0.0f;
+        }
+    }));
+}
+
+// A miss reads and decodes the file and creates a texture, so it isn't scaled by count
+void BenchTextureMiss(SDL_Renderer* renderer, std::vector<Result>& results) {
+    ResourceManager& resources = ResourceManager::Instance();
+    const std::string path = "Assets/Alien.bmp";
+
+    results.push_back(Measure("ResourceManager::LoadTexture (miss)", 1, 1, [&] {
+        sSink = resources.LoadTexture(renderer, path) ? 1.0f : 0.0f;
+    }, [&] { resources.UnloadTextures(); }));
+}
+
+void WriteJson(const char* filePath, const std::vector<Result>& results) {
+    FILE* file = std::fopen(filePath, "w");
+    if (!file) {
+        std::fprintf(stderr, "Failed to open %s\n", filePath);
+        return;
+    }
+
+    std::fprintf(file, "{\n  \"benchmarks\": [\n");
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        std::fprintf(file, "    {\"name\": \"%s\", \"count\": %d, \"ns_per_op\": %.3f, \"allocs_per_op\": %.4f}%s\n",
+                     r.name.c_str(), r.count, r.nsPerOp, r.allocsPerOp, i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(file, "  ]\n}\n");
+    std::fclose(file);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const char* jsonPath = argc > 1 ? argv[1] : nullptr;
+    const int counts[] = {100, 1000, 10000};
+
+    // A software renderer needs no window, so the texture paths run on a headless box too
+    SDL_Surface* target = SDL_CreateRGBSurfaceWithFormat(0, 64, 64, 32, SDL_PIXELFORMAT_RGBA32);
+    SDL_Renderer* renderer = SDL_CreateSoftwareRenderer(target);
+
+    std::vector<Result> results;
+    for (int count : counts) {
+        BenchComponents(count, results);
+        BenchEnemies(count, results);
+        BenchProjectiles(count, results);
+        BenchTextureHit(renderer, count, results);
+    }
+    BenchTextureMiss(renderer, results);
+
+    std::printf("%-38s %8s %12s %12s\n", "benchmark", "count", "ns/op", "allocs/op");
+    for (const Result& r : results) {
+        std::printf("%-38s %8d %12.2f %12.4f\n", r.name.c_str(), r.count, r.nsPerOp, r.allocsPerOp);
+    }
+    if (jsonPath) WriteJson(jsonPath, results);
+
+    ResourceManager::Instance().UnloadTextures();
+    SDL_DestroyRenderer(renderer);
+    SDL_FreeSurface(target);
+    Logger::Instance().Stop();
+    return 0;
+}
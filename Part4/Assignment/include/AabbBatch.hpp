@@ -0,0 +1,42 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Axis-aligned boxes packed as separate x/y/w/h arrays for batched tests.
+ */
+struct AabbSoA {
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> w;
+    std::vector<float> h;
+
+    void Clear();
+    void Reserve(std::size_t count);
+    void Push(const SDL_FRect& rect);
+    std::size_t Size() const { return x.size(); }
+};
+
+/**
+ * @brief Tests `rect` against `count` packed boxes and sets bit i of `mask` for every box i it overlaps.
+ *
+ * Uses the same predicate as GameEntity::TestCollision, so touching edges don't count
+ * and results are bit-for-bit identical to the scalar test. Runs 8 boxes per step
+ * on CPUs with AVX2 (checked at run time, no -mavx2 needed), 4 with SSE2, and
+ * falls back to scalar code elsewhere.
+ *
+ * @param mask Must hold at least (count + 63) / 64 words; it is overwritten.
+ */
+void IntersectAabbMask(const SDL_FRect& rect,
+                       const float* x, const float* y, const float* w, const float* h,
+                       std::size_t count, std::uint64_t* mask);
+
+/**
+ * @brief Appends the index of every packed box overlapping `rect` to `hits`, in ascending order.
+ *
+ * @return The number of indices appended.
+ */
+std::size_t IntersectAabbBatch(const SDL_FRect& rect, const AabbSoA& boxes, std::vector<std::uint32_t>& hits);
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Bump allocator that frees everything it handed out in one go.
+ *
+ * Memory comes from large blocks; Allocate() just advances a pointer. Objects made
+ * with New() have their destructors run, newest first, by Reset(). Use one per
+ * level (or wave): build into it, then Reset() on teardown instead of freeing
+ * objects one by one.
+ */
+class Arena {
+    public:
+        explicit Arena(std::size_t blockSize = 64 * 1024);
+        ~Arena();
+
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        void* Allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+        template <typename T, typename... Args>
+        T* New(Args&&... args) {
+            void* memory = Allocate(sizeof(T), alignof(T));
+            T* object = new (memory) T(std::forward<Args>(args)...);
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                AddDestructor(object, [](void* p) { static_cast<T*>(p)->~T(); });
+            }
+            return object;
+        }
+
+        /**
+         * @brief Runs pending destructors and frees every block but the first, which is
+         * kept (empty) for the next level.
+         */
+        void Reset();
+
+        std::size_t GetBytesUsed() const { return mBytesUsed; }
+
+    private:
+        struct Block {
+            Block* next;
+            std::size_t size;
+            std::size_t used;
+        };
+
+        struct Destructor {
+            Destructor* next;
+            void (*destroy)(void*);
+            void* object;
+        };
+
+        Block* NewBlock(std::size_t minimumSize);
+        void AddDestructor(void* object, void (*destroy)(void*));
+        static std::byte* DataOf(Block* block) { return reinterpret_cast<std::byte*>(block + 1); }
+
+        std::size_t mBlockSize;
+        Block* mBlocks{nullptr}; // newest first
+        Destructor* mDestructors{nullptr};
+        std::size_t mBytesUsed{0};
+};
+
+/**
+ * @brief Linear scratch memory for data that only lives for one tick.
+ *
+ * Allocate() bumps a pointer into one buffer; Reset() at the start of the tick
+ * makes the whole buffer available again. Nothing is destroyed, so only store
+ * trivially destructible data. If a tick needs more than the buffer holds, the
+ * overflow comes from the heap and the buffer grows to fit on the next Reset(),
+ * so a steady workload stops touching the heap after its first few ticks.
+ */
+class FrameAllocator {
+    public:
+        explicit FrameAllocator(std::size_t capacity = 256 * 1024);
+        ~FrameAllocator();
+
+        FrameAllocator(const FrameAllocator&) = delete;
+        FrameAllocator& operator=(const FrameAllocator&) = delete;
+
+        void* Allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+        /**
+         * @brief `count` default-initialized Ts (so uninitialized for plain data).
+         */
+        template <typename T>
+        std::span<T> AllocateArray(std::size_t count) {
+            static_assert(std::is_trivially_destructible_v<T>, "frame memory is never destroyed");
+            T* data = static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+            return {data, count};
+        }
+
+        void Reset();
+
+        std::size_t GetCapacity() const { return mCapacity; }
+
+    private:
+        std::byte* mBuffer{nullptr};
+        std::size_t mCapacity;
+        std::size_t mUsed{0};
+        std::size_t mOverflowBytes{0};
+        Arena mOverflow;
+};
+
+/**
+ * @brief Fixed-size slots for one type, recycled through a free list.
+ *
+ * Slots are carved from blocks of ObjectsPerBlock objects. Create() pops a free
+ * slot and Destroy() pushes it back, so a pool that has reached its working size
+ * never calls malloc. Blocks come from `arena` when one is given (and are freed
+ * when that arena resets), otherwise from the heap (freed by the pool's destructor).
+ * Every object must be destroyed before the pool or its arena goes away.
+ */
+template <typename T, std::size_t ObjectsPerBlock = 256>
+class PoolAllocator {
+    public:
+        explicit PoolAllocator(Arena* arena = nullptr) : mArena(arena) {}
+
+        ~PoolAllocator() {
+            while (mHeapBlocks) {
+                HeapBlock* next = mHeapBlocks->next;
+                ::operator delete(mHeapBlocks, std::align_val_t{alignof(HeapBlock)});
+                mHeapBlocks = next;
+            }
+        }
+
+        PoolAllocator(const PoolAllocator&) = delete;
+        PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+        template <typename... Args>
+        T* Create(Args&&... args) {
+            if (!mFree) Grow();
+            Slot* slot = mFree;
+            mFree = slot->next;
+            ++mLive;
+            return new (slot->storage) T(std::forward<Args>(args)...);
+        }
+
+        void Destroy(T* object) {
+            if (!object) return;
+            object->~T();
+            Slot* slot = reinterpret_cast<Slot*>(object);
+            slot->next = mFree;
+            mFree = slot;
+            --mLive;
+        }
+
+        /**
+         * @brief Forgets every slot. Call with no live objects, before resetting the arena.
+         */
+        void Reset() {
+            mFree = nullptr;
+            mLive = 0;
+        }
+
+        std::size_t Size() const { return mLive; }
+
+    private:
+        union Slot {
+            Slot* next;
+            alignas(T) std::byte storage[sizeof(T)];
+        };
+
+        struct HeapBlock {
+            HeapBlock* next;
+            Slot slots[ObjectsPerBlock];
+        };
+
+        void Grow() {
+            Slot* slots;
+            if (mArena) {
+                slots = static_cast<Slot*>(mArena->Allocate(sizeof(Slot) * ObjectsPerBlock, alignof(Slot)));
+            } else {
+                auto* block = static_cast<HeapBlock*>(::operator new(sizeof(HeapBlock), std::align_val_t{alignof(HeapBlock)}));
+                block->next = mHeapBlocks;
+                mHeapBlocks = block;
+                slots = block->slots;
+            }
+
+            // Thread the new slots onto the free list, lowest address first
+            for (std::size_t i = ObjectsPerBlock; i-- > 0;) {
+                slots[i].next = mFree;
+                mFree = &slots[i];
+            }
+        }
+
+        Arena* mArena;
+        HeapBlock* mHeapBlocks{nullptr};
+        Slot* mFree{nullptr};
+        std::size_t mLive{0};
+};
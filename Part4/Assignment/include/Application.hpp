@@ -5,11 +5,46 @@
 #include "GameEntity.hpp"
 #include "Player.hpp"
 #include "Enemy.hpp"
+#include "Formation.hpp"
+#include "Level.hpp"
+#include "Replay.hpp"
+#include "Snapshot.hpp"
+#include "NetServer.hpp"
+#include "NetClient.hpp"
+#include "SpatialHash.hpp"
+#include "AabbBatch.hpp"
+#include "ProjectilePool.hpp"
+#include "SpriteBatch.hpp"
+#include "CachedLayer.hpp"
+#include "Camera.hpp"
+#include "Scenario.hpp"
+#include "Allocators.hpp"
+#include "CollisionEvent.hpp"
+#include <array>
+#include <chrono>
+#include <span>
 #include <vector>
 #include <iostream>
 
 class Application {
     public:
+        /**
+         * @brief Reads the command line: `--headless` runs without a window, a file name
+         * loads a scenario, and `key=value` arguments override single scenario settings.
+         * `--threads=N` sets the number of worker threads (default: one per spare core).
+         * `--profile` prints per-zone frame timings on exit; `--trace=FILE` writes a Chrome
+         * trace of the frames picked with `--trace-frames=FIRST,COUNT` (default 0,120).
+         * `--record=FILE` saves the session's input for `--replay=FILE`, which replays it
+         * headless; `--seed=N` seeds the enemies' RNG and `--checksum-interval=N` sets
+         * how many ticks pass between world checksums in a recording.
+         * `--snapshot-check` runs the scenario through a world snapshot and back instead.
+         * `--server=PORT` hosts a network session (dedicated when headless) and
+         * `--connect=HOST:PORT` joins one; `--net-rate=HZ` sets how often snapshots and
+         * input are sent (default 30), and `--net-loss=PERCENT`, `--net-latency=MS` and
+         * `--net-jitter=MS` simulate a bad link. `--net-bench=N` serves the scenario to N
+         * simulated clients over loopback as fast as possible.
+         * `--zoom=Z` sets the camera's zoom (default 1).
+         */
         Application(int argc, char* argv[]);
 
         ~Application();
@@ -28,25 +63,275 @@ class Application {
 
         /**
          * @brief Renders the game objects to the screen.
+         *
+         * The camera follows the local player over the level's world, and whatever is
+         * outside its view isn't drawn. The formation is drawn from a cached layer that's
+         * only redrawn when an enemy joins or leaves it; moving it is one quad. Players and
+         * projectiles are drawn every frame.
+         *
+         * @param interpolation How far between the previous and current simulation step
+         * to draw moving objects (0..1).
          */
-        void Render();
+        void Render(float interpolation = 1.0f);
 
         /**
          * @brief Main application loop that handles input, updates, and rendering.
+         *
+         * The simulation advances in fixed steps of 1 / simulation rate seconds, as many
+         * as the elapsed time calls for, and each rendered frame is interpolated between
+         * the last two steps. The render rate only limits how often frames are drawn.
          * 
-         * @param targetFPS Target frames per second.
+         * @param targetFPS Target frames per second for rendering; 0 or less renders uncapped.
          */
         void Loop(float targetFPS);
 
+        /**
+         * @brief Sets how many fixed simulation steps run per second (default 120).
+         */
+        void SetSimulationRate(float stepsPerSecond) { mSimulationRate = stepsPerSecond; }
+
+        /**
+         * @brief Runs the scenario's ticks back to back with no window, input or rendering,
+         * then prints ticks/sec and where the time went.
+         */
+        void RunScenario();
+
+        /**
+         * @brief Plays back the session loaded with `--replay=FILE` as fast as possible,
+         * checking the world checksum wherever the recording has one.
+         *
+         * @return false if the simulation diverged from the recording.
+         */
+        bool RunReplay();
+
+        /**
+         * @brief Runs half the scenario, snapshots the world, runs the rest, restores the
+         * snapshot and runs the rest again, then prints how long capture and restore took.
+         *
+         * @return false if the restored world came out different from the original.
+         */
+        bool RunSnapshotCheck();
+
+        /**
+         * @brief Serializes the whole simulation into `buffer`, replacing what it held.
+         * The buffer keeps its capacity, so capturing into it again doesn't allocate.
+         * F5 captures into the quick-save slot.
+         */
+        void CaptureSnapshot(std::vector<std::byte>& buffer);
+
+        /**
+         * @brief Puts the simulation back the way it was when `snapshot` was captured,
+         * reusing the enemies and memory already there. F9 restores the quick-save.
+         *
+         * @return false if the snapshot is damaged or from another level. One from
+         * another level is refused before anything changes.
+         */
+        bool RestoreSnapshot(std::span<const std::byte> snapshot);
+
+        /**
+         * @brief Serves the session with no window, in real time, for the scenario's
+         * ticks, then prints the bandwidth used per client.
+         */
+        void RunServer();
+
+        /**
+         * @brief Runs the scenario as a server with `--net-bench` simulated clients on
+         * loopback, as fast as possible, and prints the server's tick cost per client
+         * and each client's bandwidth.
+         *
+         * @return false if a client failed to join or rebuilt a snapshot differently
+         * from what the server sent.
+         */
+        bool RunNetBench();
+
+        bool IsHeadless() const { return mHeadless; }
+
+        bool IsServing() const { return mNetMode == NetMode::Server; }
+
+        bool IsNetBenchmarking() const { return mNetBenchClients > 0; }
+
+        bool IsCheckingSnapshots() const { return mSnapshotCheck; }
+
+        bool IsReplaying() const { return mReplay.IsPlaying(); }
+
         void ShutDown();
 
     private:
-        std::shared_ptr<Player> mMainCharacter;
-        std::vector<std::shared_ptr<Enemy>> mEnemies;
+        using Clock = std::chrono::steady_clock;
+
+        enum class NetMode { Off, Server, Client };
+
+        /**
+         * @brief Calls fn(Player&, slot) for the local player and every remote one.
+         */
+        template <typename Fn>
+        void ForEachPlayer(Fn&& fn) {
+            fn(*mMainCharacter, mLocalSlot);
+            for (int slot = 0; slot < NetMaxPlayers; ++slot) {
+                if (mRemotePlayers[slot]) fn(*mRemotePlayers[slot], slot);
+            }
+        }
+
+        // Stages of Update(), each profiled as its own zone
+        void MoveFormation(float deltaTime);
+        void BuildBroadphase();
+        // Collisions run in three passes: detection only records contacts, gameplay
+        // reacts to the recorded events, and destroys take effect last, once per frame
+        void DetectCollisions();
+        void HandleCollisionEvents();
+        void ApplyDestroyRequests();
+
+        static SDL_FPoint ContactPoint(const SDL_FRect& rect, const AabbSoA& boxes, std::size_t index);
+
+        // Maps the scenario's level file (the default level when windowed), or builds its waves from rows/columns/waves
+        void LoadLevel();
+
+        // Fills the wave's formation with live enemies, recycling dead ones before creating any
+        void SpawnWave(const LevelWave& wave);
+
+        // Sends the next wave once the current one's time is up or it's cleared
+        void AdvanceWaves();
+
+        // Builds an enemy from the pool, seeded from the spawn RNG
+        Enemy* CreateEnemy();
+
+        // xorshift32 step on mSpawnRandom
+        std::uint32_t NextSpawnSeed();
+
+        // Stand-in for the keyboard in headless runs: hold fire with the scenario's cooldown
+        void AutoFire();
+
+        // Builds a player for another slot, spread out along the bottom of the screen
+        void AddRemotePlayer(int slot);
+
+        // Milliseconds on the network clock: wall time, or simulated time in the net benchmark
+        double NetTime() const;
+
+        // Server: gives joined clients a player and removes the ones that left, then feeds them their input
+        void UpdateRemotePlayers(float deltaTime);
+
+        // Server: packs the world into mNetState and sends it to every client
+        void SendWorldState();
+
+        // Client: stands in for the simulation, showing the server's world between snapshots
+        void UpdateClient(float deltaTime);
+
+        // Client: takes on a snapshot, replaying our own unacknowledged input on top of it
+        void ApplyWorldState(const NetWorldState& state);
+
+        // Swap-and-pops a live enemy onto the dead list
+        void KillEnemy(std::size_t index);
+
+        // Destroys every enemy and frees the level's memory in one go
+        void ClearLevel();
+
+        // Hash of everything the simulation steps on, for comparing a replay with its recording
+        std::uint64_t ComputeChecksum();
+
+        // Snapshots every moving object's position before a simulation step
+        void StorePreviousState();
+
+        // Redraws the cached formation layer if its members changed; false if it can't be cached
+        bool UpdateFormationLayer();
+
+        // Catch-up limit: after a long stall the simulation drops time rather than spiraling
+        static constexpr int MaxStepsPerFrame = 8;
+
+        static constexpr int WindowWidth = 800;
+        static constexpr int WindowHeight = 600;
+
+        // How close the formation may come to the sides of the world before it turns
+        static constexpr float FormationEdgeMargin = 10.0f;
+
+        // Items per job when an update pass is split across the workers
+        static constexpr std::size_t EnemyGrain = 256;
+        static constexpr std::size_t ProjectileGrain = 4096;
+        static constexpr std::size_t RowGrain = 2048;
+
+        // Every projectile in flight, player and enemy alike
+        ProjectilePool mProjectiles{65536};
+        std::unique_ptr<Player> mMainCharacter;
+        // Enemies live in pool slots carved out of the level arena; ClearLevel() hands it all back
+        Arena mLevelArena{256 * 1024};
+        PoolAllocator<Enemy> mEnemyPool{&mLevelArena};
+        std::vector<Enemy*> mEnemies; // live only, in no particular order
+        std::vector<Enemy*> mDeadEnemies; // killed this level, waiting for the next wave
+        // Scratch memory for the current tick, reset at the top of Update()
+        FrameAllocator mFrameScratch;
         SDL_Window* mWindow = nullptr;
         SDL_Renderer* mRenderer = nullptr;
+        std::unique_ptr<SpriteBatch> mSpriteBatch;
+        std::unique_ptr<CachedLayer> mFormationLayer;
+        std::uint32_t mFormationLayerVersion = 0; // formation version the layer was drawn at
         bool mRun;
         float mFramesElapsed;
+        float mSimulationRate = 120.0f;
+        bool mHeadless = false;
+        Scenario mScenario;
+        int mWorkerThreads = -1;
+        bool mPrintProfile = false;
+        std::string mTracePath;
+        unsigned long long mTraceFirstFrame = 0;
+        unsigned long long mTraceFrameCount = 120;
         float mEnemySpeed = 100.0f; // shared horizontal movement for all enemies
         bool mEnemiesShouldReverse = false; // flag to tell them to flip next frame
+        Formation mFormation; // every enemy in the current wave, moved as one block
+        // The waves being played: views into mLevelFile, or into the built-in arrays when there's no level
+        LevelFile mLevelFile;
+        std::vector<LevelPrefab> mBuiltinPrefabs;
+        std::vector<LevelWave> mBuiltinWaves;
+        std::span<const LevelPrefab> mPrefabs;
+        std::span<const LevelWave> mWaves;
+        std::size_t mNextWave = 0;
+        std::uint32_t mWaveTicks = 0;
+        std::string mLevelPath; // the level file in play, empty for the built-in waves
+        SDL_FRect mWorld{0.0f, 0.0f, LevelDefaultWorldWidth, LevelDefaultWorldHeight}; // the level's play area
+        Camera mCamera;
+        float mZoom = 1.0f;
+
+        // Record and replay
+        Replay mReplay;
+        std::string mRecordPath;
+        std::uint32_t mSeed = 1;
+        std::uint32_t mChecksumInterval = 60;
+        std::uint32_t mTick = 0; // simulation steps run so far
+        std::uint32_t mSpawnRandom = 1; // seeds each new enemy; part of snapshots so rebuilt enemies match
+
+        // World snapshots
+        std::vector<std::byte> mQuickSave;
+        bool mSnapshotCheck = false;
+
+        // Networking. Players other than the local one sit in mRemotePlayers by slot.
+        NetMode mNetMode = NetMode::Off;
+        std::uint16_t mNetPort = 0;
+        NetAddress mServerAddress;
+        LinkConditions mLinkConditions;
+        float mNetRate = 30.0f;
+        std::uint32_t mNetSendInterval = 4; // server: ticks between snapshots
+        int mNetBenchClients = 0;
+        int mLocalSlot = 0;
+        std::array<std::unique_ptr<Player>, NetMaxPlayers> mRemotePlayers;
+        NetServer mServer;
+        NetClient mClient;
+        NetWorldState mNetState; // server: the world as last sent
+        Clock::time_point mNetEpoch = Clock::now();
+        double mNetMicros = 0.0; // server: time spent receiving and sending
+        // Client: buttons by tick, for replaying unacknowledged input over a snapshot
+        std::array<std::uint8_t, 256> mInputHistory{};
+        bool mHasClientWave = false;
+        std::uint16_t mClientWave = 0;
+        std::vector<Enemy*> mSlotEnemies; // the client's enemies by formation slot
+
+        // Broadphase grids, rebuilt every Update.
+        SpatialHash mEnemyGrid;
+        SpatialHash mEnemyProjectileGrid;
+        std::vector<std::uint32_t> mCandidates;
+        // Narrowphase scratch: candidate rectangles and the indices (into mCandidates) that hit.
+        AabbSoA mCandidateBoxes;
+        std::vector<std::uint32_t> mHits;
+        // This frame's contacts, and what the response decided to destroy (flags live in mFrameScratch)
+        std::vector<CollisionEvent> mCollisionEvents;
+        std::span<std::uint8_t> mEnemyDestroyFlags;
+        std::span<std::uint8_t> mProjectileDestroyFlags;
+        std::uint32_t mDestroyPlayers = 0; // bit per player slot
 };
\ No newline at end of file
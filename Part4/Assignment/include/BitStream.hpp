@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Packs values into a caller-owned byte buffer at bit granularity, lowest bit first.
+ *
+ * Nothing is allocated. A write that doesn't fit is dropped and marks the writer
+ * as overflowed, so a packet can be built optimistically and checked once.
+ */
+class BitWriter {
+    public:
+        BitWriter(std::uint8_t* buffer, std::size_t capacityBytes);
+
+        /**
+         * @brief Writes the low `count` bits of `value` (count 1..32).
+         */
+        void WriteBits(std::uint32_t value, int count);
+
+        void WriteBool(bool value) { WriteBits(value ? 1u : 0u, 1); }
+
+        /**
+         * @brief 7 bits at a time plus a continuation bit, so small numbers stay small.
+         */
+        void WriteVarUint(std::uint32_t value);
+
+        /**
+         * @brief Zigzag-mapped VarUint: small negative deltas cost as little as small positive ones.
+         */
+        void WriteVarInt(std::int32_t value);
+
+        std::size_t GetBitsWritten() const { return mBits; }
+        std::size_t GetBitsLeft() const { return mCapacityBits - mBits; }
+        std::size_t GetBytesWritten() const { return (mBits + 7) / 8; }
+        bool HasOverflowed() const { return mOverflowed; }
+
+    private:
+        std::uint8_t* mBuffer;
+        std::size_t mCapacityBits;
+        std::size_t mBits{0};
+        bool mOverflowed{false};
+};
+
+/**
+ * @brief Reads back what a BitWriter packed. Reading past the end returns zeros
+ * and marks the reader as overflowed.
+ */
+class BitReader {
+    public:
+        BitReader(const std::uint8_t* data, std::size_t sizeBytes);
+
+        std::uint32_t ReadBits(int count);
+
+        bool ReadBool() { return ReadBits(1) != 0; }
+
+        std::uint32_t ReadVarUint();
+
+        std::int32_t ReadVarInt();
+
+        bool HasOverflowed() const { return mOverflowed; }
+
+    private:
+        const std::uint8_t* mData;
+        std::size_t mSizeBits;
+        std::size_t mBits{0};
+        bool mOverflowed{false};
+};
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include "SpriteBatch.hpp"
+#include <cstddef>
+
+/**
+ * @brief A group of sprites drawn once into an offscreen render target, then put on
+ * screen with a single quad every frame until it's invalidated.
+ *
+ * For what changes far less often than it's drawn: a static layer is never
+ * invalidated, a slow-changing one is invalidated whenever its contents change.
+ * Everything else keeps going through the sprite batch every frame. If the renderer
+ * can't draw into textures, or the layer is bigger than a texture may be, Reserve()
+ * fails and the caller draws the contents directly instead.
+ */
+class CachedLayer {
+    public:
+        explicit CachedLayer(SDL_Renderer* renderer);
+
+        ~CachedLayer();
+
+        CachedLayer(const CachedLayer&) = delete;
+        CachedLayer& operator=(const CachedLayer&) = delete;
+
+        /**
+         * @brief Makes sure the target holds at least width x height pixels. Growing
+         * it recreates the texture, which invalidates the layer.
+         *
+         * @return false if the layer can't be cached at that size.
+         */
+        bool Reserve(int width, int height);
+
+        void Invalidate() { mDirty = true; }
+
+        bool IsDirty() const { return mDirty; }
+
+        /**
+         * @brief If the layer is dirty, clears it to transparent and draws whatever
+         * `draw` queues into `batch` (in world coordinates; `origin` is the world
+         * point at the layer's top-left). Call between frames: the batch must be empty
+         * and is left empty.
+         */
+        template <typename Fn>
+        void Redraw(SpriteBatch& batch, SDL_FPoint origin, Fn&& draw) {
+            if (!mDirty || !mTexture) return;
+            BeginRedraw(batch, origin);
+            draw();
+            EndRedraw(batch);
+        }
+
+        /**
+         * @brief Queues the cached contents as one quad with the layer's top-left at `position`.
+         */
+        void Composite(SpriteBatch& batch, SDL_FPoint position, RenderLayer layer = RenderLayer::Entities);
+
+        /**
+         * @brief Times the contents were drawn again, for telling a cache that works from one that doesn't.
+         */
+        std::size_t GetRedrawCount() const { return mRedraws; }
+
+    private:
+        void BeginRedraw(SpriteBatch& batch, SDL_FPoint origin);
+        void EndRedraw(SpriteBatch& batch);
+
+        SDL_Renderer* mRenderer;
+        SDL_Texture* mTexture{nullptr};
+        int mWidth{0};
+        int mHeight{0};
+        int mMaxWidth{0};  // the renderer's texture limits; 0 if it doesn't say
+        int mMaxHeight{0};
+        bool mSupported{false};
+        bool mDirty{true};
+        std::size_t mRedraws{0};
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+/**
+ * @brief The window's view onto a world that can be bigger than it.
+ *
+ * The camera has a position (the world point at the window's top-left) and a zoom
+ * (window pixels per world unit). It never shows past the world's edges: a view
+ * smaller than the world is kept inside it, and a bigger one is centred on it.
+ * Render code draws in world coordinates through GetView() and skips whatever
+ * IsVisible() says is outside.
+ */
+class Camera {
+    public:
+        /**
+         * @brief Sets the size of the window in pixels.
+         */
+        void SetViewport(float width, float height);
+
+        void SetWorldBounds(const SDL_FRect& bounds);
+
+        const SDL_FRect& GetWorldBounds() const { return mWorld; }
+
+        /**
+         * @brief Sets window pixels per world unit; above 1 zooms in. Non-positive values are ignored.
+         */
+        void SetZoom(float zoom);
+
+        float GetZoom() const { return mZoom; }
+
+        /**
+         * @brief Moves the view's top-left to `position`, as far as the world allows.
+         */
+        void SetPosition(SDL_FPoint position);
+
+        SDL_FPoint GetPosition() const { return {mView.x, mView.y}; }
+
+        /**
+         * @brief Centres the view on `target`, as far as the world allows.
+         */
+        void Follow(SDL_FPoint target);
+
+        /**
+         * @brief The part of the world on screen.
+         */
+        const SDL_FRect& GetView() const { return mView; }
+
+        bool IsVisible(const SDL_FRect& rect) const {
+            return rect.x < mView.x + mView.w && rect.x + rect.w > mView.x &&
+                   rect.y < mView.y + mView.h && rect.y + rect.h > mView.y;
+        }
+
+    private:
+        // Keeps mView's position inside the world, or centred on it if the view is bigger
+        void Clamp();
+
+        SDL_FRect mWorld{0.0f, 0.0f, 800.0f, 600.0f};
+        SDL_FRect mView{0.0f, 0.0f, 800.0f, 600.0f};
+        SDL_FPoint mViewport{800.0f, 600.0f};
+        float mZoom{1.0f};
+};
@@ -9,11 +9,11 @@ public:
     Collision2DComponent();
     ~Collision2DComponent();
 
-    ComponentType GetType() override { return ComponentType::Collision2DComponent; }
+    ComponentType GetType() override { return ComponentTypeOf<Collision2DComponent>; }
 
     void Input(float deltaTime) override {}
     void Update(float deltaTime) override;
-    void Render(SDL_Renderer* renderer) override;
+    void Render(SpriteBatch& batch) override;
 
     void Move(float dx, float dy);
     
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+
+/**
+ * @brief What a collider belongs to; says how to read the matching id in a CollisionEvent.
+ */
+enum class CollisionLayer : std::uint8_t {
+    Player,          // id is the player slot (0 unless networked)
+    Enemy,           // id indexes the enemy list
+    PlayerProjectile, // id indexes the projectile pool
+    EnemyProjectile   // id indexes the projectile pool
+};
+
+/**
+ * @brief One contact found by collision detection, for gameplay to react to later.
+ *
+ * Detection only appends these; nothing in the world changes until the frame's
+ * events are handled and the resulting destroys are applied.
+ */
+struct CollisionEvent {
+    std::uint32_t a;
+    std::uint32_t b;
+    CollisionLayer layerA;
+    CollisionLayer layerB;
+    SDL_FPoint contact; // centre of the overlap
+};
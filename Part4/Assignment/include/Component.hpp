@@ -1,7 +1,8 @@
 #pragma once
 #include <SDL2/SDL.h>
 #include "ComponentType.hpp"
-#include <memory>
+#include "EntityRegistry.hpp"
+#include "SpriteBatch.hpp"
 
 class GameEntity;
 
@@ -15,20 +16,24 @@ struct Component {
 
     virtual void Update(float deltaTime) {}
 
-    virtual void Render(SDL_Renderer* renderer) {}
+    virtual void Render(SpriteBatch& batch) {}
 
     // Pure virtual function must be implemented.
     virtual ComponentType GetType() = 0;
 
-    // Set and get the owning GameEntity
-    void SetGameEntity(std::shared_ptr<GameEntity> entity) {
+    // Set and get the owning GameEntity. The link is a non-owning id, so a
+    // component never keeps its entity alive.
+    void SetGameEntity(EntityId entity) {
         mGameEntity = entity;
     }
 
-    std::shared_ptr<GameEntity> GetGameEntity() const {
-        return mGameEntity;
+    /**
+     * @brief The owning entity, or nullptr if it's gone (or was never set).
+     */
+    GameEntity* GetGameEntity() const {
+        return EntityRegistry::Instance().Get(mGameEntity);
     }
 
 protected:
-    std::shared_ptr<GameEntity> mGameEntity;
-};
\ No newline at end of file
+    EntityId mGameEntity;
+};
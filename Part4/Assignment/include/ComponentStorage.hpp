@@ -0,0 +1,222 @@
+#pragma once
+
+#include "Component.hpp"
+#include "ComponentType.hpp"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class GameEntity;
+class Archetype;
+
+// One bit per ComponentType. Entities carrying the same set of components
+// share an Archetype, and therefore share contiguous storage.
+using ComponentSignature = std::uint32_t;
+
+constexpr ComponentSignature SignatureOf(ComponentType type) {
+    return ComponentSignature{1} << static_cast<unsigned>(type);
+}
+
+// Where an entity's components live: which archetype, and which row of it.
+struct EntityLocation {
+    Archetype* archetype{nullptr};
+    std::size_t row{0};
+};
+
+/**
+ * @brief Type-erased handle to one packed array of components.
+ */
+class ComponentColumnBase {
+    public:
+        virtual ~ComponentColumnBase() {}
+
+        virtual Component* At(std::size_t row) = 0;
+
+        /**
+         * @brief Appends row `row` of `other`, which must hold the same component type.
+         */
+        virtual void PushFrom(ComponentColumnBase& other, std::size_t row) = 0;
+
+        /**
+         * @brief Removes `row` by moving the last element into its place.
+         */
+        virtual void SwapRemove(std::size_t row) = 0;
+
+        /**
+         * @brief Creates an empty column holding the same component type.
+         */
+        virtual std::unique_ptr<ComponentColumnBase> CloneEmpty() const = 0;
+};
+
+template <typename T>
+class ComponentColumn : public ComponentColumnBase {
+    public:
+        Component* At(std::size_t row) override { return &mData[row]; }
+
+        void PushFrom(ComponentColumnBase& other, std::size_t row) override {
+            mData.push_back(std::move(static_cast<ComponentColumn<T>&>(other).mData[row]));
+        }
+
+        void SwapRemove(std::size_t row) override {
+            if (row + 1 != mData.size()) {
+                mData[row] = std::move(mData.back());
+            }
+            mData.pop_back();
+        }
+
+        std::unique_ptr<ComponentColumnBase> CloneEmpty() const override {
+            return std::make_unique<ComponentColumn<T>>();
+        }
+
+        std::vector<T> mData;
+};
+
+/**
+ * @brief All entities that share one component signature.
+ *
+ * Each component type in the signature gets its own contiguous array, and row i
+ * of every array belongs to the same entity. Systems can walk those arrays
+ * linearly instead of looking components up entity by entity.
+ */
+class Archetype {
+    public:
+        explicit Archetype(ComponentSignature signature) : mSignature(signature) {}
+
+        ComponentSignature GetSignature() const { return mSignature; }
+
+        bool Has(ComponentType type) const { return (mSignature & SignatureOf(type)) != 0; }
+
+        std::size_t Size() const { return mEntities.size(); }
+
+        GameEntity* GetEntity(std::size_t row) const { return mEntities[row]; }
+
+        /**
+         * @brief Returns the component of the given type at `row`, or nullptr if this archetype lacks it.
+         */
+        Component* Get(ComponentType type, std::size_t row) {
+            auto& column = mColumns[static_cast<std::size_t>(type)];
+            return column ? column->At(row) : nullptr;
+        }
+
+        /**
+         * @brief Returns the packed array of T, or nullptr if this archetype lacks it.
+         */
+        template <typename T>
+        T* Data() {
+            auto& column = mColumns[static_cast<std::size_t>(ComponentTypeOf<T>)];
+            return column ? static_cast<ComponentColumn<T>*>(column.get())->mData.data() : nullptr;
+        }
+
+        template <typename Fn>
+        void ForEachComponent(std::size_t row, Fn&& fn) {
+            for (auto& column : mColumns) {
+                if (column) fn(*column->At(row));
+            }
+        }
+
+    private:
+        friend class ComponentStorage;
+
+        ComponentSignature mSignature;
+        std::array<std::unique_ptr<ComponentColumnBase>, ComponentTypeCount> mColumns;
+        std::vector<GameEntity*> mEntities;
+};
+
+/**
+ * @brief Owns every component in the game, grouped by archetype.
+ *
+ * Pointers handed out by the storage stay valid until the next structural
+ * change (adding a component or destroying an entity), since either can
+ * move rows around.
+ */
+class ComponentStorage {
+    public:
+        static ComponentStorage& Instance();
+
+        /**
+         * @brief Stores `component` for `entity`, moving the entity into the archetype
+         * that also holds T. Replaces the existing component if there is one.
+         *
+         * @return Pointer to the stored component.
+         */
+        template <typename T>
+        T* Add(GameEntity* entity, EntityLocation& location, const T& component);
+
+        /**
+         * @brief Releases the row at `location` and resets it.
+         */
+        void Remove(EntityLocation& location);
+
+        /**
+         * @brief Makes room for `count` more entities carrying exactly Ts, so spawning
+         * them in bulk appends to their archetype without regrowing its arrays.
+         */
+        template <typename... Ts>
+        void Reserve(std::size_t count);
+
+        /**
+         * @brief Calls fn(Archetype&) for every non-empty archetype containing all of `required`.
+         */
+        template <typename Fn>
+        void ForEachArchetype(ComponentSignature required, Fn&& fn) {
+            for (auto& archetype : mArchetypes) {
+                if ((archetype->mSignature & required) == required && archetype->Size() > 0) {
+                    fn(*archetype);
+                }
+            }
+        }
+
+    private:
+        ComponentStorage() {}
+
+        Archetype& FindOrCreate(ComponentSignature signature, const Archetype* from);
+        void MoveEntity(GameEntity* entity, EntityLocation& location, Archetype& target);
+        void RemoveRow(Archetype& archetype, std::size_t row);
+
+        static ComponentStorage* mInstance;
+        std::vector<std::unique_ptr<Archetype>> mArchetypes;
+};
+
+template <typename T>
+T* ComponentStorage::Add(GameEntity* entity, EntityLocation& location, const T& component) {
+    constexpr ComponentType type = ComponentTypeOf<T>;
+    const std::size_t index = static_cast<std::size_t>(type);
+    Archetype* current = location.archetype;
+
+    if (current && current->Has(type)) {
+        T& existing = static_cast<ComponentColumn<T>&>(*current->mColumns[index]).mData[location.row];
+        existing = component;
+        return &existing;
+    }
+
+    ComponentSignature signature = SignatureOf(type);
+    if (current) signature |= current->mSignature;
+
+    Archetype& target = FindOrCreate(signature, current);
+    auto& column = target.mColumns[index];
+    if (!column) {
+        column = std::make_unique<ComponentColumn<T>>();
+    }
+
+    auto& typed = static_cast<ComponentColumn<T>&>(*column);
+    typed.mData.push_back(component);
+    MoveEntity(entity, location, target);
+    return &typed.mData.back();
+}
+
+template <typename... Ts>
+void ComponentStorage::Reserve(std::size_t count) {
+    Archetype& archetype = FindOrCreate((SignatureOf(ComponentTypeOf<Ts>) | ...), nullptr);
+    const std::size_t capacity = archetype.Size() + count;
+
+    auto reserveColumn = [&]<typename T>() {
+        auto& column = archetype.mColumns[static_cast<std::size_t>(ComponentTypeOf<T>)];
+        if (!column) {
+            column = std::make_unique<ComponentColumn<T>>();
+        }
+        static_cast<ComponentColumn<T>&>(*column).mData.reserve(capacity);
+    };
+    (reserveColumn.template operator()<Ts>(), ...);
+    archetype.mEntities.reserve(capacity);
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstddef>
 // Our 'key' when adding to a game object is based off
 // of this enum.
 //
@@ -8,4 +9,40 @@ enum class ComponentType : short {
     TransformComponent,
     Collision2DComponent,
     InputComponent
-};
\ No newline at end of file
+};
+
+// Number of entries in ComponentType, used to size per-type tables.
+constexpr std::size_t ComponentTypeCount = 4;
+
+class TextureComponent;
+class TransformComponent;
+class Collision2DComponent;
+class InputComponent;
+
+// Compile-time registry mapping each component class to its ComponentType.
+// Asking for a class that isn't registered here fails to compile.
+template <typename T>
+struct ComponentTraits;
+
+template <>
+struct ComponentTraits<TextureComponent> {
+    static constexpr ComponentType Type = ComponentType::TextureComponent;
+};
+
+template <>
+struct ComponentTraits<TransformComponent> {
+    static constexpr ComponentType Type = ComponentType::TransformComponent;
+};
+
+template <>
+struct ComponentTraits<Collision2DComponent> {
+    static constexpr ComponentType Type = ComponentType::Collision2DComponent;
+};
+
+template <>
+struct ComponentTraits<InputComponent> {
+    static constexpr ComponentType Type = ComponentType::InputComponent;
+};
+
+template <typename T>
+constexpr ComponentType ComponentTypeOf = ComponentTraits<T>::Type;
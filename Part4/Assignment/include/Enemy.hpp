@@ -1,64 +1,132 @@
 #pragma once
 
 #include "GameEntity.hpp"
-#include "Projectile.hpp"
+#include "ProjectilePool.hpp"
+#include "Formation.hpp"
+
+/**
+ * @brief One enemy's simulation state as plain data, for world snapshots.
+ */
+struct EnemyState {
+    SDL_FRect rectangle;
+    ProjectileLauncher launcher;
+    Uint64 nextLaunchTime;
+    float minLaunchTime;
+    std::uint32_t fireIntervalMin;
+    std::uint32_t fireIntervalRange;
+    std::uint32_t random;
+    SDL_FPoint formationOffset;
+    std::int32_t column;
+    std::int32_t row;
+    bool inFormation;
+    bool renderable;
+};
 
 class Enemy : public GameEntity {
     public:
         /**
-         * @brief Constructs an Enemy entity with a given sprite and renderer.
+         * @brief Constructs an Enemy entity. Its sprite loads in the background.
          * 
-         * Initializes the enemy with a sprite, creates a projectile for the enemy, and
-         * sets up movement and launch timings for the projectile (using Rand()).
+         * Initializes the enemy with a sprite and sets up launch timings for its
+         * projectiles from `seed`.
          * 
-         * @param renderer The SDL_Renderer used for rendering the enemy's projectile.
-         * @param sprite The sprite representing the enemy.
+         * @param projectiles The pool the enemy's shots are spawned into.
+         * @param seed Starts the enemy's own RNG; any value works, but equal seeds fire alike.
          */
-        Enemy(SDL_Renderer* renderer);
+        Enemy(ProjectilePool& projectiles, std::uint32_t seed);
 
         ~Enemy();
 
         /**
-         * @brief Updates the enemy's state, including movement and projectile actions.
+         * @brief Updates the enemy's state, including movement and firing.
          * 
-         * The enemy moves horizontally, changing direction when reaching the offset bounds.
-         * It also updates the projectile's state and launches the projectile if the enemy is renderable.
+         * An enemy in a formation snaps to its slot; one on its own moves horizontally in
+         * the group direction.
+         * It also launches a projectile when its next launch time comes up, if the enemy is renderable.
          * 
          * @param deltaTime The time elapsed since the last update, used for frame-rate independent movement.
          */
         void Update(float deltaTime) override;
 
         /**
-         * @brief Renders the enemy and its projectile to the screen.
+         * @brief Renders the enemy to the screen.
          * 
-         * This function renders the projectile and the enemy sprite, but only if the
+         * This function renders the enemy sprite, but only if the
          * enemy is set to be rendered.
          * 
-         * @param renderer The SDL_Renderer used for rendering the enemy and its projectile.
+         * @param batch The sprite batch the enemy's quads are queued into.
          */
-        void Render(SDL_Renderer* renderer) override;
+        void Render(SpriteBatch& batch) override;
 
         /**
-         * @brief Gets the enemy's projectile.
-         * 
-         * Returns the shared pointer to the projectile associated with this enemy.
-         * 
-         * @return A shared pointer to the enemy's projectile.
+         * @brief Brings a dead (or reused) enemy back for a new wave without rebuilding it.
+         *
+         * Makes it renderable again and schedules its next shot from now, so a
+         * recycled enemy doesn't fire the moment it reappears.
+         */
+        void Revive();
+
+        /**
+         * @brief Sets the range of random waits between shots, in ms (default 1000..4000).
+         */
+        void SetFireInterval(float minMs, float maxMs);
+
+        /**
+         * @brief Takes a slot in `formation`. From then on the enemy's position is the
+         * formation origin plus the slot's offset, instead of moving on its own.
+         * Leave any previous formation first.
+         */
+        void JoinFormation(Formation& formation, int column, int row);
+
+        /**
+         * @brief Frees the enemy's formation slot, if it has one.
+         */
+        void LeaveFormation();
+
+        /**
+         * @brief Moves the enemy to its slot at the formation's current origin.
          */
-        std::shared_ptr<Projectile> GetProjectile();
+        void SnapToFormation();
+
+        bool IsInFormation() const { return mFormation != nullptr; }
+        int GetColumn() const { return mColumn; }
+        int GetRow() const { return mRow; }
+
+        void SaveState(EnemyState& state);
+
+        /**
+         * @brief Puts the enemy back into a saved state. A saved formation slot is
+         * taken in `formation` without touching its counts, which the formation's
+         * own snapshot restores.
+         */
+        void LoadState(const EnemyState& state, Formation& formation);
         
         static bool sMoveRight;
 
         static float sGroupSpeed;
 
+        // Multiplier on how often every enemy fires (2 = twice as often)
+        static float sFireRate;
+
     private:
+        // xorshift32 step on mRandom
+        std::uint32_t NextRandom();
+
         Uint64 nextLaunchTime;
         bool xPositiveDirection{true};
         float offset{0.0f};
         float mSpeed{100.0f}; 
-        std::shared_ptr<Projectile> mProjectile;
+        ProjectilePool* mProjectiles;
+        ProjectileLauncher mLauncher;
         float minLaunchTime{5000};
+        std::uint32_t mFireIntervalMin{1000};
+        std::uint32_t mFireIntervalRange{3000};
         float homeX;
+        std::uint32_t mRandom; // per-enemy RNG state, so updates can run on any thread
+        Formation* mFormation{nullptr};
+        SDL_FPoint mFormationOffset{0.0f, 0.0f};
+        int mColumn{0};
+        int mRow{0};
         
 
 };
\ No newline at end of file
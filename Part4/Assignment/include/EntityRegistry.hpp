@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+class GameEntity;
+
+/**
+ * @brief Weak, copyable reference to a GameEntity: a slot index plus the slot's
+ * generation when the entity was created. Once the entity is destroyed the slot's
+ * generation moves on, so stale ids resolve to nullptr instead of dangling.
+ */
+struct EntityId {
+    std::uint32_t index{0};
+    std::uint32_t generation{0}; // 0 is never handed out, so EntityId{} is always invalid
+
+    bool operator==(const EntityId& other) const {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const EntityId& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief Slot table mapping EntityIds to live entities.
+ *
+ * Every GameEntity registers itself on construction and unregisters on
+ * destruction. Lookups are one bounds check and one generation compare.
+ * Freed slots are reused most-recently-freed first, with their generation
+ * bumped.
+ */
+class EntityRegistry {
+    public:
+        static EntityRegistry& Instance();
+
+        EntityId Create(GameEntity* entity);
+
+        /**
+         * @brief Frees the slot. Ids that still point at it stop resolving.
+         */
+        void Destroy(EntityId id);
+
+        /**
+         * @brief The entity `id` refers to, or nullptr if it has been destroyed.
+         */
+        GameEntity* Get(EntityId id) const {
+            if (id.index >= mSlots.size()) return nullptr;
+            const Slot& slot = mSlots[id.index];
+            return slot.generation == id.generation ? slot.entity : nullptr;
+        }
+
+        bool IsAlive(EntityId id) const { return Get(id) != nullptr; }
+
+        std::size_t GetLiveCount() const { return mSlots.size() - mFree.size(); }
+
+    private:
+        struct Slot {
+            GameEntity* entity{nullptr};
+            std::uint32_t generation{1};
+        };
+
+        EntityRegistry() {}
+
+        static EntityRegistry* mInstance;
+        std::vector<Slot> mSlots;
+        std::vector<std::uint32_t> mFree;
+};
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <vector>
+
+class SnapshotWriter;
+class SnapshotReader;
+
+/**
+ * @brief A rows x columns block of members that move together.
+ *
+ * Members sit at fixed offsets from one shared origin, so moving the whole block
+ * is a single Move() on the origin. The block keeps a live count per column and
+ * per row; when a member leaves, an edge row or column that empties is dropped
+ * from the bounds. GetBounds() is therefore O(1), and keeping it current costs
+ * O(1) amortized per departure.
+ */
+class Formation {
+    public:
+        /**
+         * @brief Lays out an empty columns x rows grid with its top-left slot at `origin`.
+         *
+         * @param spacing Distance between neighbouring slots.
+         * @param memberSize Size of one member, for the bounds.
+         */
+        void Reset(int columns, int rows, SDL_FPoint origin, SDL_FPoint spacing, SDL_FPoint memberSize);
+
+        /**
+         * @brief Marks the slot as occupied. Each slot holds at most one member.
+         */
+        void Join(int column, int row);
+
+        /**
+         * @brief Marks an occupied slot as free again.
+         */
+        void Leave(int column, int row);
+
+        void Move(float dx, float dy) {
+            mOrigin.x += dx;
+            mOrigin.y += dy;
+        }
+
+        SDL_FPoint GetOrigin() const { return mOrigin; }
+
+        void SetOrigin(SDL_FPoint origin) { mOrigin = origin; }
+
+        /**
+         * @brief Remembers the origin as the start of the next simulation step.
+         */
+        void StorePrevious() { mPreviousOrigin = mOrigin; }
+
+        /**
+         * @brief The origin `t` (0..1) of the way from the previous step to the current one.
+         */
+        SDL_FPoint GetInterpolatedOrigin(float t) const {
+            return {mPreviousOrigin.x + (mOrigin.x - mPreviousOrigin.x) * t,
+                    mPreviousOrigin.y + (mOrigin.y - mPreviousOrigin.y) * t};
+        }
+
+        SDL_FPoint GetOffset(int column, int row) const { return {column * mSpacing.x, row * mSpacing.y}; }
+
+        /**
+         * @brief World-space box around every live member.
+         */
+        SDL_FRect GetBounds() const;
+
+        bool IsEmpty() const { return mLive == 0; }
+
+        /**
+         * @brief Size of the whole grid, from the top-left slot to the far edge of the bottom-right member.
+         */
+        SDL_FPoint GetExtent() const;
+
+        /**
+         * @brief Changes whenever the layout is reset or a member joins or leaves, so a
+         * cached picture of the formation knows when it's out of date. Moving doesn't count.
+         */
+        std::uint32_t GetVersion() const { return mVersion; }
+
+        /**
+         * @brief Appends the layout, the live counts and the edges to a snapshot.
+         */
+        void SaveState(SnapshotWriter& writer) const;
+
+        /**
+         * @brief Overwrites the formation with a snapshot written by SaveState(). The
+         * count arrays are reused, so this only allocates for a bigger grid than any so far.
+         */
+        bool LoadState(SnapshotReader& reader);
+
+        /**
+         * @brief Moves `reader` past a section written by SaveState() without loading it.
+         *
+         * @return false if the section is damaged, exactly when LoadState() would fail.
+         */
+        static bool SkipState(SnapshotReader& reader);
+
+    private:
+        SDL_FPoint mOrigin{0.0f, 0.0f};
+        SDL_FPoint mPreviousOrigin{0.0f, 0.0f};
+        SDL_FPoint mSpacing{0.0f, 0.0f};
+        SDL_FPoint mMemberSize{0.0f, 0.0f};
+        std::vector<std::uint32_t> mColumnCount;
+        std::vector<std::uint32_t> mRowCount;
+        // Live edges, as slot indices; only valid while mLive > 0
+        int mFirstColumn{0};
+        int mLastColumn{-1};
+        int mFirstRow{0};
+        int mLastRow{-1};
+        std::uint32_t mLive{0};
+        std::uint32_t mVersion{0};
+};
@@ -1,11 +1,12 @@
 #pragma once
 
 #include "TextureComponent.hpp"
-#include <map>
 #include "TransformComponent.hpp"
+#include "Collision2DComponent.hpp"
+#include "ComponentStorage.hpp"
 #include "iostream"
 
-class GameEntity : public std::enable_shared_from_this<GameEntity> {
+class GameEntity {
     public:
         /**
          * @brief Handles input for the game entity.
@@ -16,16 +17,20 @@ class GameEntity : public std::enable_shared_from_this<GameEntity> {
 
         virtual ~GameEntity();
 
+        // Entities are registered by address, so they stay put
+        GameEntity(const GameEntity&) = delete;
+        GameEntity& operator=(const GameEntity&) = delete;
+
         virtual void Input(float deltaTime);
         virtual void Update(float deltaTime);
-        virtual void Render(SDL_Renderer* renderer);
+        virtual void Render(SpriteBatch& batch);
 
         /**
          * @brief Compares the parameter rectangle with the calling GameEntities rectangle to see if there is any overlap.
          * 
-         * @param otherRect The other rectangle to compare against.
+         * @param other The other entity to compare against.
         */
-        bool TestCollision(std::shared_ptr<GameEntity> enemy);
+        bool TestCollision(GameEntity& other);
 
         /**
          * @brief Sets whether the entity should be rendered or not.
@@ -43,21 +48,67 @@ class GameEntity : public std::enable_shared_from_this<GameEntity> {
         bool GetRenderable();
 
 
-        void AddComponent(ComponentType type, std::shared_ptr<Component> component);
+        /**
+         * @brief Copies a component into ComponentStorage, moving this entity into the
+         * archetype that includes T.
+         *
+         * @return Reference to the stored copy. Valid until the next structural change.
+         */
+        template <typename T>
+        T& AddComponent(const T& component);
 
+        /**
+         * @brief Checks the entity's signature for T. No lookup, no cast.
+         */
+        template <typename T>
+        bool HasComponent() const {
+            return (mSignature & SignatureOf(ComponentTypeOf<T>)) != 0;
+        }
 
+        /**
+         * @brief Returns this entity's T. The entity must have one (see HasComponent).
+         */
         template <typename T>
-        std::shared_ptr<T> GetComponent(ComponentType type);
+        T& GetComponent() {
+            return mLocation.archetype->Data<T>()[mLocation.row];
+        }
 
-        std::shared_ptr<GameEntity> GetThisPtr();
+        /**
+         * @brief Returns this entity's T, or nullptr if it has none.
+         */
+        template <typename T>
+        T* TryGetComponent() {
+            return HasComponent<T>() ? &GetComponent<T>() : nullptr;
+        }
+
+        /**
+         * @brief This entity's handle. Components and other systems hold this instead of a pointer.
+         */
+        EntityId GetId() const { return mId; }
 
         void AddDefaultTransform();
         
-        std::shared_ptr<TransformComponent> GetTransform();
+        TransformComponent& GetTransform() { return GetComponent<TransformComponent>(); }
 
         void InitializeComponents();
 
+        /**
+         * @brief Calls fn(Component&) for each component this entity has, in ComponentType order.
+         */
+        template <typename Fn>
+        void ForEachComponent(Fn&& fn) {
+            if (mLocation.archetype) {
+                mLocation.archetype->ForEachComponent(mLocation.row, fn);
+            }
+        }
+
     protected:
-        std::map<ComponentType, std::shared_ptr<Component>> mComponents;
+        friend class ComponentStorage;
+
+        EntityId mId;
+        // Our row in ComponentStorage; the components themselves live there.
+        EntityLocation mLocation;
+        // One bit per component type this entity has.
+        ComponentSignature mSignature{0};
         bool mRenderable{true};
 };
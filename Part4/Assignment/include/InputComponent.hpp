@@ -3,10 +3,18 @@
 #include "Component.hpp"
 #include "ComponentType.hpp"
 #include <SDL2/SDL.h>
+#include <cstdint>
 
 // Forward declaration
 class Player;
 
+// Buttons the player can hold, as bits of one byte so a tick's input is easy to record
+enum InputButton : std::uint8_t {
+    InputLeft = 1 << 0,
+    InputRight = 1 << 1,
+    InputFire = 1 << 2
+};
+
 class InputComponent : public Component {
 public:
     InputComponent() = default;
@@ -14,10 +22,16 @@ public:
 
     void Input(float deltaTime) override;
     void Update(float deltaTime) override {}
-    void Render(SDL_Renderer* renderer) override {}
+    void Render(SpriteBatch& batch) override {}
+
+    ComponentType GetType() override { return ComponentTypeOf<InputComponent>; }
 
-    ComponentType GetType() override { return ComponentType::InputComponent; }
+    /**
+     * @brief How far the held buttons move the player in deltaTime. Network clients
+     * use it to replay their own input on top of the server's position.
+     */
+    static float MoveX(std::uint8_t buttons, float deltaTime);
 
 private:
-    float mSpeed = 300.0f; // Player speed
+    static constexpr float Speed = 300.0f; // Player speed
 };
\ No newline at end of file
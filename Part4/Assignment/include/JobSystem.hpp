@@ -0,0 +1,130 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Tracks a batch of jobs; Wait() on it returns once they have all run.
+ */
+struct JobCounter {
+    std::atomic<std::size_t> pending{0};
+};
+
+/**
+ * @brief Work-stealing thread pool.
+ *
+ * Every worker (and the dispatching thread, as slot 0) has its own queue. A thread
+ * pops its newest job first and, when it runs dry, steals the oldest job from
+ * another queue. ParallelFor() cuts a range into fixed-size chunks, so the same
+ * range is always split the same way whatever the thread count; as long as chunks
+ * only write their own elements, results don't depend on scheduling.
+ *
+ * With no workers started everything runs on the calling thread inside Wait().
+ * Jobs must not dispatch more jobs.
+ */
+class JobSystem {
+    public:
+        static JobSystem& Instance();
+
+        /**
+         * @brief Starts `workerCount` worker threads (0 runs everything on the caller).
+         */
+        void Start(std::size_t workerCount);
+
+        /**
+         * @brief Joins the workers. Jobs still queued run on whoever Wait()s for them.
+         */
+        void Stop();
+
+        std::size_t GetWorkerCount() const { return mThreads.size(); }
+
+        /**
+         * @brief Queues fn(begin, end) over [0, count) in chunks of `grain` items without
+         * waiting. `fn` must stay alive until Wait(counter) returns.
+         */
+        template<typename Fn>
+        void ParallelFor(std::size_t count, std::size_t grain, Fn& fn, JobCounter& counter) {
+            if (count == 0) return;
+            if (grain == 0) grain = 1;
+            Dispatch(&Invoke<Fn>, &fn, count, grain, counter);
+        }
+
+        /**
+         * @brief Runs fn(begin, end) over [0, count) in chunks of `grain` items and waits.
+         */
+        template<typename Fn>
+        void ParallelFor(std::size_t count, std::size_t grain, Fn&& fn) {
+            JobCounter counter;
+            ParallelFor(count, grain, fn, counter);
+            Wait(counter);
+        }
+
+        /**
+         * @brief Queues fn() as a single job. `fn` must stay alive until Wait(counter) returns.
+         */
+        template<typename Fn>
+        void Run(Fn& fn, JobCounter& counter) {
+            Dispatch(&InvokeOnce<Fn>, &fn, 1, 1, counter);
+        }
+
+        /**
+         * @brief Runs queued jobs on the calling thread until every job in `counter` is done.
+         */
+        void Wait(JobCounter& counter);
+
+    private:
+        using JobFunction = void (*)(void* context, std::size_t begin, std::size_t end);
+
+        struct Job {
+            JobFunction function;
+            void* context;
+            std::size_t begin;
+            std::size_t end;
+            JobCounter* counter;
+        };
+
+        // Ring buffer of jobs. It only ever grows, so once it has held a frame's worth
+        // of jobs, queuing more never allocates.
+        struct WorkQueue {
+            std::mutex mutex;
+            std::vector<Job> ring = std::vector<Job>(256);
+            std::size_t head = 0; // oldest job
+            std::size_t count = 0;
+
+            void PushBack(const Job& job);
+            Job PopBack();
+            Job PopFront();
+        };
+
+        template<typename Fn>
+        static void Invoke(void* context, std::size_t begin, std::size_t end) {
+            (*static_cast<Fn*>(context))(begin, end);
+        }
+
+        template<typename Fn>
+        static void InvokeOnce(void* context, std::size_t, std::size_t) {
+            (*static_cast<Fn*>(context))();
+        }
+
+        JobSystem();
+        void Dispatch(JobFunction function, void* context, std::size_t count, std::size_t grain, JobCounter& counter);
+        bool PopOrSteal(std::size_t self, Job& job);
+        void Execute(const Job& job);
+        void WorkerThread(std::size_t index);
+
+        static JobSystem* mInstance;
+
+        // Slot 0 belongs to whichever thread dispatches; workers use 1..N
+        std::vector<std::unique_ptr<WorkQueue>> mQueues;
+        std::vector<std::thread> mThreads;
+
+        std::mutex mSleepMutex;
+        std::condition_variable mWake;
+        std::atomic<std::size_t> mQueued{0};
+        std::atomic<bool> mRunning{false};
+};
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <type_traits>
+
+/*
+ * Binary level format (version 2), little-endian, every record 4-byte aligned:
+ *
+ *   LevelHeader               (version 1 headers end before the world size)
+ *   LevelPrefab[prefabCount]  at prefabOffset
+ *   LevelWave[waveCount]      at waveOffset
+ *   LevelSlot[slotCount]      at slotOffset
+ *
+ * The records are read in place from the mapped file, so they hold only fixed-size
+ * plain data. Build a .level from a text description with tools/LevelConverter.cpp.
+ */
+
+inline constexpr char LevelMagic[4] = {'S', 'I', 'L', 'V'};
+inline constexpr std::uint16_t LevelVersion = 2;
+inline constexpr std::uint16_t LevelHeaderSizeV1 = 32;
+
+// The world of a level that doesn't give one: exactly the window
+inline constexpr float LevelDefaultWorldWidth = 800.0f;
+inline constexpr float LevelDefaultWorldHeight = 600.0f;
+
+// Longest side a world may have. Multiplayer sends projectile positions as 16-bit
+// quarter pixels (up to 8191.75), so every world stays a margin inside that.
+inline constexpr float LevelMaxWorldSize = 8000.0f;
+
+inline bool IsValidWorldSize(float size) {
+    return std::isfinite(size) && size > 0.0f && size <= LevelMaxWorldSize;
+}
+
+// Most slots one wave's grid may have. The loader, scenarios and network decoder
+// all hold waves to it, so nothing read from outside sizes a grid past it.
+inline constexpr std::size_t LevelMaxWaveSlots = 1 << 20;
+
+struct LevelHeader {
+    char magic[4];
+    std::uint16_t version;
+    std::uint16_t headerSize;   // sizeof(LevelHeader), so later versions can grow it
+    std::uint32_t prefabCount;
+    std::uint32_t waveCount;
+    std::uint32_t slotCount;
+    std::uint32_t prefabOffset;
+    std::uint32_t waveOffset;
+    std::uint32_t slotOffset;
+    float worldWidth;           // the play area, from (0, 0); the camera scrolls over it
+    float worldHeight;
+};
+
+/**
+ * @brief What an enemy looks like and how often it shoots.
+ */
+struct LevelPrefab {
+    char texture[64];            // asset path, NUL-terminated
+    float width;
+    float height;
+    float minFireIntervalMs;     // each shot waits a random time in [min, max)
+    float maxFireIntervalMs;
+};
+
+/**
+ * @brief One wave: a formation of `columns` x `rows` slots filled with one prefab.
+ *
+ * With slotCount 0 every slot is filled; otherwise only the listed slots are.
+ */
+struct LevelWave {
+    std::uint32_t prefab;
+    std::uint16_t columns;
+    std::uint16_t rows;
+    float originX;               // top-left slot
+    float originY;
+    float spacingX;
+    float spacingY;
+    float fireRate;              // multiplier on the prefab's fire rate
+    std::uint32_t ticks;         // simulation steps until the next wave; 0 waits for a clear
+    std::uint32_t firstSlot;
+    std::uint32_t slotCount;
+};
+
+struct LevelSlot {
+    std::uint16_t column;
+    std::uint16_t row;
+};
+
+static_assert(std::is_trivially_copyable_v<LevelHeader> && sizeof(LevelHeader) == 40);
+static_assert(std::is_trivially_copyable_v<LevelPrefab> && sizeof(LevelPrefab) == 80);
+static_assert(std::is_trivially_copyable_v<LevelWave> && sizeof(LevelWave) == 40);
+static_assert(std::is_trivially_copyable_v<LevelSlot> && sizeof(LevelSlot) == 4);
+
+/**
+ * @brief A .level file mapped read-only into memory.
+ *
+ * Open() maps the file and checks every count, offset and index once; after that
+ * the accessors hand out views straight into the mapping, so loading a level
+ * costs no parsing and no allocations whatever its size. The views stay valid
+ * until Close() or destruction.
+ */
+class LevelFile {
+    public:
+        LevelFile() = default;
+        ~LevelFile();
+
+        LevelFile(const LevelFile&) = delete;
+        LevelFile& operator=(const LevelFile&) = delete;
+
+        /**
+         * @brief Maps and validates `filePath`, replacing any level already open.
+         *
+         * @return false (and logs why) if the file can't be read or isn't a valid level.
+         */
+        bool Open(const std::string& filePath);
+
+        void Close();
+
+        bool IsOpen() const { return mData != nullptr; }
+
+        std::span<const LevelPrefab> GetPrefabs() const { return mPrefabs; }
+        std::span<const LevelWave> GetWaves() const { return mWaves; }
+
+        float GetWorldWidth() const { return mWorldWidth; }
+        float GetWorldHeight() const { return mWorldHeight; }
+
+        /**
+         * @brief The slots a wave fills, or an empty span if it fills its whole grid.
+         */
+        std::span<const LevelSlot> GetSlots(const LevelWave& wave) const {
+            return mSlots.subspan(wave.firstSlot, wave.slotCount);
+        }
+
+    private:
+        bool Validate(const std::string& filePath);
+
+        const std::byte* mData{nullptr};
+        std::size_t mSize{0};
+        std::span<const LevelPrefab> mPrefabs;
+        std::span<const LevelWave> mWaves;
+        std::span<const LevelSlot> mSlots;
+        float mWorldWidth{LevelDefaultWorldWidth};
+        float mWorldHeight{LevelDefaultWorldHeight};
+};
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <atomic>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+// Compile-time log levels. Calls below LOG_LEVEL expand to nothing, so their
+// arguments aren't even evaluated. Override with e.g. -DLOG_LEVEL=LOG_LEVEL_TRACE.
+#define LOG_LEVEL_TRACE 0
+#define LOG_LEVEL_DEBUG 1
+#define LOG_LEVEL_INFO 2
+#define LOG_LEVEL_WARN 3
+#define LOG_LEVEL_ERROR 4
+#define LOG_LEVEL_OFF 5
+
+#ifndef LOG_LEVEL
+#ifdef NDEBUG
+#define LOG_LEVEL LOG_LEVEL_INFO
+#else
+#define LOG_LEVEL LOG_LEVEL_DEBUG
+#endif
+#endif
+
+enum class LogLevel : std::uint8_t {
+    Trace,
+    Debug,
+    Info,
+    Warn,
+    Error
+};
+
+enum class LogCategory : std::uint8_t {
+    Core,
+    Entity,
+    Input,
+    Enemy,
+    Collision,
+    Projectile,
+    Resource,
+    Net,
+    Count
+};
+
+/**
+ * @brief Asynchronous logger: callers format into a lock-free ring buffer and a
+ * background thread does the actual writing.
+ *
+ * Write() never blocks and never allocates. It claims a slot in a bounded
+ * multi-producer queue, formats the message into it with snprintf and
+ * publishes it. If the queue is full, or the category has used up its
+ * per-second budget, the message is dropped and counted instead.
+ */
+class Logger {
+    public:
+        static Logger& Instance();
+
+        /**
+         * @brief Queues a printf-style message. Prefer the LOG_* macros, which compile
+         * out below LOG_LEVEL.
+         */
+        void Write(LogLevel level, LogCategory category, const char* format, ...)
+#if defined(__GNUC__)
+            __attribute__((format(printf, 4, 5)))
+#endif
+            ;
+
+        /**
+         * @brief Caps how many messages a category may log per second; 0 means no cap.
+         * Warnings and errors are never held to it, so chatter can't crowd them out.
+         */
+        void SetRateLimit(LogCategory category, std::uint32_t messagesPerSecond);
+
+        /**
+         * @brief Blocks until every message queued before the call has been written.
+         */
+        void Flush();
+
+        /**
+         * @brief Writes what's queued and stops the writer thread. Later messages are
+         * still queued, but only written if the ring has room and Flush() is called.
+         */
+        void Stop();
+
+        /**
+         * @brief Messages dropped because the ring was full or a rate limit was hit.
+         */
+        std::uint64_t GetDroppedCount() const { return mDropped.load(std::memory_order_relaxed); }
+
+    private:
+        static constexpr std::size_t Capacity = 4096; // must be a power of two
+        static constexpr std::size_t MessageSize = 192;
+
+        struct Slot {
+            std::atomic<std::size_t> sequence;
+            std::int64_t timestamp; // ns since the logger started
+            LogLevel level;
+            LogCategory category;
+            char text[MessageSize];
+        };
+
+        struct RateWindow {
+            std::atomic<std::int64_t> start{0};
+            std::atomic<std::uint32_t> count{0};
+            std::atomic<std::uint32_t> limit{0};
+        };
+
+        Logger();
+        bool Admit(LogCategory category, std::int64_t now);
+        std::size_t Drain();
+        void WriterThread();
+
+        static Logger* mInstance;
+
+        std::unique_ptr<Slot[]> mSlots;
+        alignas(64) std::atomic<std::size_t> mEnqueuePos{0};
+        alignas(64) std::atomic<std::size_t> mDequeuePos{0};
+        std::atomic<std::uint64_t> mDropped{0};
+        std::array<RateWindow, static_cast<std::size_t>(LogCategory::Count)> mRates;
+
+        std::int64_t mStartTime;
+        std::atomic<bool> mRunning{true};
+        std::thread mWriter;
+};
+
+#if LOG_LEVEL <= LOG_LEVEL_TRACE
+#define LOG_TRACE(category, ...) Logger::Instance().Write(LogLevel::Trace, LogCategory::category, __VA_ARGS__)
+#else
+#define LOG_TRACE(category, ...) ((void)0)
+#endif
+
+#if LOG_LEVEL <= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(category, ...) Logger::Instance().Write(LogLevel::Debug, LogCategory::category, __VA_ARGS__)
+#else
+#define LOG_DEBUG(category, ...) ((void)0)
+#endif
+
+#if LOG_LEVEL <= LOG_LEVEL_INFO
+#define LOG_INFO(category, ...) Logger::Instance().Write(LogLevel::Info, LogCategory::category, __VA_ARGS__)
+#else
+#define LOG_INFO(category, ...) ((void)0)
+#endif
+
+#if LOG_LEVEL <= LOG_LEVEL_WARN
+#define LOG_WARN(category, ...) Logger::Instance().Write(LogLevel::Warn, LogCategory::category, __VA_ARGS__)
+#else
+#define LOG_WARN(category, ...) ((void)0)
+#endif
+
+#if LOG_LEVEL <= LOG_LEVEL_ERROR
+#define LOG_ERROR(category, ...) Logger::Instance().Write(LogLevel::Error, LogCategory::category, __VA_ARGS__)
+#else
+#define LOG_ERROR(category, ...) ((void)0)
+#endif
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "NetProtocol.hpp"
+#include "NetSocket.hpp"
+#include <array>
+#include <cstdint>
+
+/**
+ * @brief The client end of a network session: joins a server, sends its input and
+ * rebuilds the world from the server's delta-compressed snapshots.
+ *
+ * Every input packet acknowledges the newest snapshot received, which the server
+ * then uses as the baseline for the next ones. Snapshots that arrive late or out of
+ * order are dropped; a lost one only means the next delta is against an older ack.
+ */
+class NetClient {
+    public:
+        /**
+         * @brief Starts joining `server`. Receive() repeats the request until the
+         * server answers.
+         */
+        bool Connect(const NetAddress& server, double nowMs);
+
+        /**
+         * @brief Tells the server we're leaving and closes the socket.
+         */
+        void Disconnect(double nowMs);
+
+        bool IsConnected() const { return mStatus == Status::Connected; }
+        bool WasRejected() const { return mStatus == Status::Rejected; }
+
+        const NetServerInfo& GetServerInfo() const { return mInfo; }
+
+        void SetConditions(const LinkConditions& conditions) { mSocket.SetConditions(conditions); }
+
+        /**
+         * @brief Handles every waiting packet from the server.
+         *
+         * @return true if a newer world state arrived (see GetState()).
+         */
+        bool Receive(double nowMs);
+
+        bool HasState() const { return mHasState; }
+        const NetWorldState& GetState() const { return mStates[mLatest % HistorySize]; }
+
+        /**
+         * @brief The newest of our input ticks the server had used when it built the
+         * latest state. Input after it still has to be replayed on top of that state.
+         */
+        bool HasInputAck() const { return mHasInputAck; }
+        std::uint32_t GetInputAck() const { return mInputAck; }
+
+        /**
+         * @brief Notes the buttons held at `tick`. Every send interval, the newest
+         * NetInputRedundancy ticks go out in one packet with the snapshot ack.
+         */
+        void SendInput(std::uint32_t tick, std::uint8_t buttons, double nowMs);
+
+        void Flush(double nowMs) { mSocket.Flush(nowMs); }
+
+        std::uint64_t GetBytesReceived() const { return mBytesReceived; }
+        std::uint64_t GetBytesSent() const { return mSocket.GetBytesSent(); }
+        std::uint64_t GetPacketsSent() const { return mSocket.GetPacketsSent(); }
+        std::size_t GetSnapshotsReceived() const { return mSnapshotsReceived; }
+
+        static constexpr std::size_t HistorySize = 32;
+
+    private:
+        enum class Status { Off, Connecting, Connected, Rejected };
+
+        void SendConnect(double nowMs);
+        void HandleSnapshot(BitReader& reader);
+
+        static constexpr double ConnectRetryMs = 100.0;
+
+        NetSocket mSocket;
+        NetAddress mServer;
+        Status mStatus{Status::Off};
+        double mLastConnectMs{0.0};
+        NetServerInfo mInfo;
+
+        // Received states, kept as baselines for the ones still to come
+        std::array<NetWorldState, HistorySize> mStates;
+        std::array<bool, HistorySize> mValid{};
+        bool mHasState{false};
+        std::uint16_t mLatest{0};
+        bool mHasInputAck{false};
+        std::uint32_t mInputAck{0};
+
+        std::array<std::uint8_t, NetInputRedundancy> mRecentButtons{};
+        std::uint32_t mInputTicks{0}; // ticks of input noted so far
+
+        std::uint64_t mBytesReceived{0};
+        std::size_t mSnapshotsReceived{0};
+};
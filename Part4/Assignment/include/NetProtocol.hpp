@@ -0,0 +1,126 @@
+#pragma once
+
+#include "BitStream.hpp"
+#include "ProjectilePool.hpp"
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Sent in every connect request; a server ignores requests that don't match
+constexpr std::uint32_t NetProtocolId = 0x53494E31; // "SIN1"
+
+// Player slots, the host's included (slot 0)
+constexpr int NetMaxPlayers = 16;
+
+// Each input packet repeats this many of the latest ticks, so losing one loses nothing
+constexpr int NetInputRedundancy = 8;
+
+// Positions go over the wire in quarter pixels
+constexpr float NetPositionScale = 4.0f;
+
+inline std::int32_t QuantizePosition(float value) { return static_cast<std::int32_t>(std::lround(value * NetPositionScale)); }
+inline float DequantizePosition(std::int32_t value) { return static_cast<float>(value) / NetPositionScale; }
+
+// First byte of every packet
+enum class NetPacket : std::uint8_t {
+    Connect,    // client -> server: protocol id
+    Accept,     // server -> client: NetServerInfo
+    Reject,     // server -> client: no free slot
+    Input,      // client -> server: snapshot ack and the latest ticks of input
+    Snapshot,   // server -> client: world state, delta-compressed against an acked one
+    Disconnect  // client -> server
+};
+
+/**
+ * @brief What a client needs to know about the session it joined.
+ */
+struct NetServerInfo {
+    std::uint8_t slot{0};            // the client's player slot
+    std::uint8_t sendInterval{4};    // ticks between snapshots (and between input packets)
+    float simulationRate{120.0f};
+    char level[64]{};                // level file the server plays, NUL-terminated; empty for built-in waves
+};
+
+struct NetPlayerState {
+    std::int32_t x{0};
+    std::int32_t y{0};
+    bool connected{false};
+    bool alive{false};
+
+    bool operator==(const NetPlayerState&) const = default;
+};
+
+/**
+ * @brief A projectile as the client knows it: where it was at `tick`. It flies
+ * straight at ProjectilePool::Speed, so that's enough to place it at any later tick.
+ */
+struct NetProjectile {
+    std::uint32_t id;
+    std::int32_t x;
+    std::int32_t y;
+    std::uint32_t tick;
+    ProjectileTeam team;
+
+    bool operator==(const NetProjectile&) const = default;
+};
+
+/**
+ * @brief The world as the network sees it, quantized.
+ *
+ * Enemies aren't listed one by one: every live enemy sits in a formation slot, so
+ * the formation origin plus one alive bit per slot places all of them.
+ */
+struct NetWorldState {
+    std::uint16_t sequence{0};
+    std::uint32_t tick{0};
+
+    // The wave in play; `wave` counts waves spawned, so each new wave gets a new number
+    std::uint16_t wave{0};
+    std::uint8_t prefab{0};
+    std::uint16_t columns{0};
+    std::uint16_t rows{0};
+    std::int32_t spacingX{0};
+    std::int32_t spacingY{0};
+    std::int32_t originX{0};
+    std::int32_t originY{0};
+    bool moveRight{true};
+    std::vector<std::uint64_t> alive; // bit per slot, row-major
+
+    std::array<NetPlayerState, NetMaxPlayers> players{};
+    std::vector<NetProjectile> projectiles; // sorted by id
+
+    /**
+     * @brief Sets up an all-alive columns x rows grid, reusing the bit array.
+     */
+    void ResetSlots(std::uint16_t columnCount, std::uint16_t rowCount);
+
+    bool IsAlive(std::size_t slot) const { return (alive[slot >> 6] >> (slot & 63)) & 1; }
+    void SetAlive(std::size_t slot) { alive[slot >> 6] |= std::uint64_t{1} << (slot & 63); }
+
+    bool operator==(const NetWorldState&) const = default;
+};
+
+/**
+ * @brief Writes `state` as its differences from `baseline` (or from an empty world).
+ *
+ * Projectiles that are new since the baseline are written until the packet is
+ * full; the rest wait for a later snapshot. `sent` receives exactly what the
+ * receiver will rebuild, to serve as the baseline once it's acked.
+ */
+void EncodeWorldState(const NetWorldState& state, const NetWorldState* baseline, BitWriter& writer,
+                      NetWorldState& sent);
+
+/**
+ * @brief Rebuilds a state from EncodeWorldState()'s output and the same baseline.
+ *
+ * @return false if the data is cut short or doesn't fit the baseline.
+ */
+bool DecodeWorldState(BitReader& reader, const NetWorldState* baseline, NetWorldState& state);
+
+/**
+ * @brief True if sequence number `a` is newer than `b`, allowing for wrap-around.
+ */
+inline bool SequenceNewer(std::uint16_t a, std::uint16_t b) {
+    return a != b && static_cast<std::uint16_t>(a - b) < 0x8000;
+}
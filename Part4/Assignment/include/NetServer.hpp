@@ -0,0 +1,108 @@
+#pragma once
+
+#include "NetProtocol.hpp"
+#include "NetSocket.hpp"
+#include <array>
+#include <cstdint>
+
+/**
+ * @brief The authoritative end of a network session.
+ *
+ * Clients join by sending a connect request and get a player slot (1 and up; slot
+ * 0 is the host). Their input arrives a few ticks at a time and is queued, and the
+ * game takes one tick of it per simulation step. Every snapshot is delta-compressed
+ * per client against the last snapshot that client acknowledged, so a client only
+ * pays for what changed since then.
+ */
+class NetServer {
+    public:
+        /**
+         * @brief Starts listening on `port` (0 picks a free one; see GetPort()).
+         * `info` is sent to every client that joins, with its own slot filled in.
+         */
+        bool Open(std::uint16_t port, const NetServerInfo& info);
+
+        void Close();
+
+        std::uint16_t GetPort() const { return mSocket.GetPort(); }
+
+        void SetConditions(const LinkConditions& conditions) { mSocket.SetConditions(conditions); }
+
+        /**
+         * @brief Handles every waiting packet: joins, input, acks and leaves. Clients
+         * not heard from for TimeoutMs are dropped.
+         */
+        void Receive(double nowMs);
+
+        bool IsConnected(int slot) const { return mClients[slot].connected; }
+
+        /**
+         * @brief The buttons `slot` holds this tick: its next queued input, or the last
+         * one again if nothing new has arrived.
+         */
+        std::uint8_t NextInput(int slot);
+
+        /**
+         * @brief Sends `state` to every client, each as a delta against its last ack.
+         */
+        void SendSnapshots(const NetWorldState& state, double nowMs);
+
+        /**
+         * @brief Sends the packets held back by simulated latency that are due.
+         */
+        void Flush(double nowMs) { mSocket.Flush(nowMs); }
+
+        int GetClientCount() const;
+
+        /**
+         * @brief The snapshot `slot` was sent as `sequence`, as the client will have
+         * rebuilt it, or nullptr once it has left the history.
+         */
+        const NetWorldState* FindSent(int slot, std::uint16_t sequence) const;
+
+        std::uint64_t GetBytesSent() const { return mSocket.GetBytesSent(); }
+        std::uint64_t GetPacketsSent() const { return mSocket.GetPacketsSent(); }
+
+        // Snapshots remembered per client as possible baselines
+        static constexpr std::size_t HistorySize = 32;
+
+        static constexpr double TimeoutMs = 5000.0;
+
+    private:
+        struct TickInput {
+            std::uint32_t tick;
+            std::uint8_t buttons;
+        };
+
+        struct Client {
+            bool connected{false};
+            NetAddress address;
+            double lastHeardMs{0.0};
+
+            // Input not yet used, oldest first, in a ring
+            std::array<TickInput, 64> inputs{};
+            std::size_t inputHead{0};
+            std::size_t inputCount{0};
+            bool hasInput{false};
+            std::uint32_t lastQueuedTick{0};
+            std::uint8_t buttons{0};
+            bool hasApplied{false};
+            std::uint32_t appliedTick{0}; // client tick of the input used last
+
+            std::array<NetWorldState, HistorySize> sent;
+            bool hasAck{false};
+            std::uint16_t ackedSequence{0};
+        };
+
+        void HandleConnect(const NetAddress& from, BitReader& reader, double nowMs);
+        void HandleInput(Client& client, BitReader& reader);
+        int FindClient(const NetAddress& address) const;
+
+        // Most ticks of input a client may have queued; beyond that the oldest are skipped to catch up
+        static constexpr std::size_t MaxQueuedInputs = 16;
+
+        NetSocket mSocket;
+        NetServerInfo mInfo;
+        std::array<Client, NetMaxPlayers> mClients;
+        std::uint16_t mNextSequence{0};
+};
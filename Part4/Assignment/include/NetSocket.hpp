@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Largest datagram the game sends or accepts; stays under a typical 1500-byte MTU
+constexpr std::size_t NetMaxPacket = 1200;
+
+// IPv4 and UDP headers, counted when reporting bandwidth
+constexpr std::size_t NetPacketOverhead = 28;
+
+/**
+ * @brief An IPv4 address and port, both in host byte order.
+ */
+struct NetAddress {
+    std::uint32_t ip{0};
+    std::uint16_t port{0};
+
+    bool operator==(const NetAddress& other) const { return ip == other.ip && port == other.port; }
+
+    /**
+     * @brief Parses "a.b.c.d:port" or "localhost:port".
+     */
+    static bool Parse(const char* text, NetAddress& address);
+};
+
+/**
+ * @brief A bad network, simulated on the sending side: each packet is dropped with
+ * `lossPercent` probability, otherwise held back for `latencyMs` plus up to `jitterMs`.
+ */
+struct LinkConditions {
+    float lossPercent{0.0f};
+    float latencyMs{0.0f};
+    float jitterMs{0.0f};
+};
+
+/**
+ * @brief Non-blocking UDP socket with optional simulated loss and latency.
+ *
+ * Delayed packets wait in a queue until Flush() is called with a time past their
+ * due time, so the same code runs against the wall clock or a simulated one.
+ */
+class NetSocket {
+    public:
+        NetSocket() = default;
+        ~NetSocket();
+
+        NetSocket(const NetSocket&) = delete;
+        NetSocket& operator=(const NetSocket&) = delete;
+
+        /**
+         * @brief Binds to `port` on every interface; 0 picks a free port.
+         */
+        bool Open(std::uint16_t port);
+
+        void Close();
+
+        bool IsOpen() const { return mSocket != InvalidSocket; }
+
+        std::uint16_t GetPort() const { return mPort; }
+
+        void SetConditions(const LinkConditions& conditions) { mConditions = conditions; }
+
+        /**
+         * @brief Sends now, later (simulated latency) or never (simulated loss).
+         */
+        void Send(const NetAddress& to, const void* data, std::size_t size, double nowMs);
+
+        /**
+         * @brief Sends the delayed packets that are due by `nowMs`.
+         */
+        void Flush(double nowMs);
+
+        /**
+         * @brief Copies the next waiting datagram into `buffer`.
+         *
+         * @return Its size, or 0 when nothing is waiting.
+         */
+        std::size_t Receive(NetAddress& from, void* buffer, std::size_t size);
+
+        // Totals since Open(), dropped packets included in neither byte count
+        std::uint64_t GetBytesSent() const { return mBytesSent; }
+        std::uint64_t GetPacketsSent() const { return mPacketsSent; }
+        std::uint64_t GetPacketsDropped() const { return mPacketsDropped; }
+
+    private:
+        static constexpr std::intptr_t InvalidSocket = -1;
+
+        struct Delayed {
+            double dueMs;
+            NetAddress to;
+            std::uint16_t size;
+            std::uint8_t data[NetMaxPacket];
+        };
+
+        void SendNow(const NetAddress& to, const void* data, std::size_t size);
+
+        // Uniform in [0, 1), xorshift32 on mRandom
+        float NextRandom();
+
+        std::intptr_t mSocket{InvalidSocket};
+        std::uint16_t mPort{0};
+        LinkConditions mConditions;
+        std::uint32_t mRandom{0x2545F491u};
+        std::vector<Delayed> mDelayed;
+
+        std::uint64_t mBytesSent{0};
+        std::uint64_t mPacketsSent{0};
+        std::uint64_t mPacketsDropped{0};
+};
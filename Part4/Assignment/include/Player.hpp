@@ -1,18 +1,16 @@
 #pragma once
 
 #include "GameEntity.hpp"
-#include "Projectile.hpp"
+#include "ProjectilePool.hpp"
 
 class Player : public GameEntity {
     public:
         /**
-         * @brief Constructs a Player entity with a given sprite and renderer.
-         * This function should create and resize a Projectile.
+         * @brief Constructs a Player entity. Its sprite loads in the background.
          * 
-         * @param renderer The SDL_Renderer used for rendering the player's projectile.
-         * @param sprite The sprite representing the player.
+         * @param projectiles The pool the player's shots are spawned into.
          */
-        Player(SDL_Renderer* renderer);
+        Player(ProjectilePool& projectiles);
 
         ~Player();
 
@@ -26,27 +24,40 @@ class Player : public GameEntity {
         void Input(float deltaTime) override;
 
         /**
-         * @brief Updates the Player entity and its projectile.
+         * @brief Updates the Player entity.
          * 
          * @param deltaTime The time elapsed since the last frame, used for frame-independent updates.
          */
         void Update(float deltaTime) override;
 
         /**
-         * @brief Renders the Player and its projectile.
+         * @brief Renders the Player.
          * 
-         * @param renderer The SDL_Renderer used to draw the player and projectile on the screen.
+         * @param batch The sprite batch the player's quads are queued into.
          */
-        virtual void Render(SDL_Renderer* renderer) override;
+        virtual void Render(SpriteBatch& batch) override;
 
         /**
-         * @brief Retrieves the projectile associated with the player.
+         * @brief Fires a shot upwards from (x, y) unless the player is still cooling down.
          * 
-         * @return A shared pointer to the player's projectile.
+         * @param minLaunchTime The minimum time (in milliseconds) required between shots.
          */
-        std::shared_ptr<Projectile> GetProjectile();
+        void Launch(float x, float y, float minLaunchTime);
+
+        /**
+         * @brief Sets the InputButton bits held this tick; the input component acts on them.
+         */
+        void SetInputButtons(std::uint8_t buttons) { mInputButtons = buttons; }
+
+        std::uint8_t GetInputButtons() const { return mInputButtons; }
+
+        // Firing cooldown, for world snapshots
+        const ProjectileLauncher& GetLauncher() const { return mLauncher; }
+        void SetLauncher(const ProjectileLauncher& launcher) { mLauncher = launcher; }
 
     private:
         float mSpeed{100.0f}; 
-        std::shared_ptr<Projectile> mProjectile;
+        ProjectilePool* mProjectiles;
+        ProjectileLauncher mLauncher;
+        std::uint8_t mInputButtons{0};
 };
\ No newline at end of file
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Set to 0 (e.g. -DPROFILER_ENABLED=0) to compile every PROFILE_SCOPE out.
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED 1
+#endif
+
+/**
+ * @brief Frame profiler fed by RAII zones (see PROFILE_SCOPE).
+ *
+ * Each thread records finished zones into its own buffer. EndFrame() collects
+ * every buffer, adds up each zone's time for the frame and keeps the last
+ * HistoryFrames totals per zone, which Report() turns into min/avg/p99. While
+ * a capture is running, the raw zones are also kept and written out as a
+ * Chrome trace_event JSON file (open it in chrome://tracing or Perfetto).
+ *
+ * Zone names must be string literals (or otherwise outlive the profiler):
+ * zones are grouped by pointer, not by comparing strings.
+ */
+class Profiler {
+    public:
+        static Profiler& Instance();
+
+        static std::int64_t Now() {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        /**
+         * @brief Records a finished zone on the calling thread. Called by ProfileZone.
+         */
+        void Record(const char* name, std::int64_t start, std::int64_t end);
+
+        /**
+         * @brief Marks the start of a frame; EndFrame() then records the whole frame as a
+         * "Frame" zone. Zones recorded before it still count toward this frame.
+         */
+        void BeginFrame();
+
+        /**
+         * @brief Collects this frame's zones from every thread and updates the stats.
+         */
+        void EndFrame();
+
+        /**
+         * @brief Writes frames [firstFrame, firstFrame + frameCount) to `filePath` as a
+         * Chrome trace once the last of them has ended.
+         */
+        void RequestCapture(const std::string& filePath, std::uint64_t firstFrame, std::uint64_t frameCount);
+
+        /**
+         * @brief Prints min/avg/p99 milliseconds per frame for every zone seen recently.
+         */
+        void Report(FILE* out) const;
+
+        /**
+         * @brief Forgets all stats and the frame count. Captures in progress are dropped.
+         */
+        void Reset();
+
+        std::uint64_t GetFrameIndex() const { return mFrameIndex; }
+
+    private:
+        static constexpr std::size_t HistoryFrames = 1024;
+        static constexpr std::size_t MaxEventsPerThread = 1 << 16;
+
+        struct Event {
+            const char* name;
+            std::int64_t start;
+            std::int64_t end;
+        };
+
+        struct ThreadBuffer {
+            std::mutex mutex;
+            std::vector<Event> events;
+            std::uint32_t threadId;
+        };
+
+        struct ZoneStats {
+            std::vector<float> frameMs; // ring of per-frame totals
+            std::size_t next{0};
+            std::int64_t currentFrame{0};
+            bool seenThisFrame{false};
+        };
+
+        struct CapturedEvent {
+            Event event;
+            std::uint32_t threadId;
+        };
+
+        Profiler() { mScratch.reserve(1024); }
+        ThreadBuffer& LocalBuffer();
+        void WriteCapture();
+
+        static Profiler* mInstance;
+
+        mutable std::mutex mBuffersMutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> mBuffers;
+
+        // Main thread only (BeginFrame/EndFrame/Report)
+        std::uint64_t mFrameIndex{0};
+        std::int64_t mFrameStart{0};
+        std::vector<Event> mScratch;
+        std::unordered_map<const char*, ZoneStats> mZones;
+
+        std::string mCapturePath;
+        std::uint64_t mCaptureFirst{0};
+        std::uint64_t mCaptureEnd{0};
+        std::vector<CapturedEvent> mCaptured;
+};
+
+/**
+ * @brief Times the enclosing scope and records it with the profiler.
+ */
+class ProfileZone {
+    public:
+        explicit ProfileZone(const char* name) : mName(name), mStart(Profiler::Now()) {}
+        ~ProfileZone() { Profiler::Instance().Record(mName, mStart, Profiler::Now()); }
+
+        ProfileZone(const ProfileZone&) = delete;
+        ProfileZone& operator=(const ProfileZone&) = delete;
+
+    private:
+        const char* mName;
+        std::int64_t mStart;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#if PROFILER_ENABLED
+#define PROFILE_SCOPE(name) ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(name)
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#endif
@@ -0,0 +1,200 @@
+#pragma once
+
+#include "SpriteBatch.hpp"
+#include "ResourceManager.hpp"
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class SnapshotWriter;
+class SnapshotReader;
+
+// Which side fired a projectile. Player shots hit enemies, enemy shots hit the player.
+enum class ProjectileTeam : std::uint8_t {
+    Player,
+    Enemy
+};
+
+/**
+ * @brief Per-shooter firing state: who is shooting and when they last fired.
+ */
+struct ProjectileLauncher {
+    std::uint32_t owner{0};
+    ProjectileTeam team{ProjectileTeam::Enemy};
+    Uint64 lastLaunchTime{0};
+};
+
+/**
+ * @brief Fixed-capacity store for every live projectile.
+ *
+ * Projectiles are plain rows in parallel arrays (position, size, velocity, owner,
+ * team, remaining lifetime). Live rows are always packed at the front: spawning
+ * appends and despawning swap-removes, so both are O(1), and Update() walks the
+ * arrays in one pass. Nothing is allocated after construction.
+ */
+class ProjectilePool {
+    public:
+        explicit ProjectilePool(std::size_t capacity);
+
+        /**
+         * @brief Creates launch state for a new shooter, with its cooldown starting now.
+         */
+        ProjectileLauncher CreateLauncher(ProjectileTeam team);
+
+        /**
+         * @brief Fires a projectile from (x, y) if at least minLaunchTime milliseconds
+         * have passed since this launcher last fired.
+         *
+         * @param launcher The shooter's launch state; its cooldown is restarted on success.
+         * @param x The x-coordinate from which the projectile will be launched.
+         * @param y The y-coordinate from which the projectile will be launched.
+         * @param directionUp True to fire upwards (player), false for downwards (enemy).
+         * @param minLaunchTime The minimum time (in milliseconds) required between launches.
+         * @return true if a projectile was spawned.
+         */
+        bool Launch(ProjectileLauncher& launcher, float x, float y, bool directionUp, float minLaunchTime = 1000);
+
+        /**
+         * @brief Thread-safe version of Launch() for entity updates running on worker
+         * threads: the request is only recorded. FlushLaunches() carries it out.
+         */
+        void QueueLaunch(ProjectileLauncher& launcher, float x, float y, bool directionUp, float minLaunchTime = 1000);
+
+        /**
+         * @brief Launches every queued request, ordered by launcher owner so the result
+         * doesn't depend on which thread queued first.
+         */
+        void FlushLaunches();
+
+        /**
+         * @brief Appends a projectile. Returns false when the pool is full.
+         */
+        bool Spawn(float x, float y, float vx, float vy, std::uint32_t owner, ProjectileTeam team);
+
+        /**
+         * @brief Removes projectile `index` by moving the last live projectile into its slot.
+         */
+        void Despawn(std::size_t index);
+
+        /**
+         * @brief Moves every projectile and despawns the ones that left the world or expired.
+         * Also advances the pool's clock, which all launch cooldowns are measured against.
+         * 
+         * Same as AdvanceClock(), Integrate() over every projectile, then RemoveExpired().
+         */
+        void Update(float deltaTime);
+
+        void AdvanceClock(float deltaTime) { mTime += deltaTime; }
+
+        /**
+         * @brief Moves projectiles [begin, end). Disjoint ranges may run on different threads.
+         */
+        void Integrate(std::size_t begin, std::size_t end, float deltaTime);
+
+        /**
+         * @brief Despawns the projectiles that left the world or ran out of lifetime.
+         */
+        void RemoveExpired();
+
+        /**
+         * @brief Sets the world a projectile may fly in; one that leaves it is despawned.
+         */
+        void SetBounds(const SDL_FRect& bounds) { mBounds = bounds; }
+
+        /**
+         * @brief Remembers every projectile's position as the start of the next simulation step.
+         */
+        void StorePrevious();
+
+        /**
+         * @brief Queues every live projectile that overlaps `view` into the sprite batch,
+         * blended between the previous and current step by the batch's interpolation factor.
+         */
+        void Render(SpriteBatch& batch, const SDL_FRect& view);
+
+        /**
+         * @brief Appends the clock, the owner counter and the live rows of every array to a snapshot.
+         */
+        void SaveState(SnapshotWriter& writer) const;
+
+        /**
+         * @brief Overwrites the pool with a snapshot written by SaveState(). Nothing is
+         * allocated; pending launches are dropped and the restored positions become
+         * the previous step too, so nothing slides in from where it was.
+         *
+         * @return false if the snapshot holds more projectiles than the pool can.
+         */
+        bool LoadState(SnapshotReader& reader);
+
+        /**
+         * @brief Moves `reader` past a section written by SaveState() without loading it.
+         *
+         * @return false if the section is damaged or holds more projectiles than the pool can.
+         */
+        bool SkipState(SnapshotReader& reader) const;
+
+        /**
+         * @brief Simulated milliseconds since the pool was created. Advances only in Update(),
+         * so cooldowns behave the same regardless of frame rate.
+         */
+        Uint64 GetTicks() const { return static_cast<Uint64>(mTime * 1000.0); }
+
+        void SetSprite(const AtlasRegion& sprite) { mSprite = sprite; }
+
+        std::size_t Size() const { return mCount; }
+        std::size_t Capacity() const { return mX.size(); }
+
+        SDL_FRect GetRectangle(std::size_t index) const {
+            return {mX[index], mY[index], mW[index], mH[index]};
+        }
+
+        ProjectileTeam GetTeam(std::size_t index) const { return mTeam[index]; }
+        std::uint32_t GetOwner(std::size_t index) const { return mOwner[index]; }
+
+        // Numbered in spawn order and never reused, so a projectile keeps its id while rows move around
+        std::uint32_t GetProjectileId(std::size_t index) const { return mId[index]; }
+
+        // Every projectile flies straight up or down at this speed, in pixels per second
+        static constexpr float Speed = 200.0f;
+
+    private:
+        static constexpr float Width = 6.0f;
+        static constexpr float Height = 20.0f;
+        static constexpr float Lifetime = 10.0f; // seconds
+
+        std::size_t mCount{0};
+        std::uint32_t mNextOwner{0};
+        std::uint32_t mNextId{0};
+        double mTime{0.0}; // seconds
+
+        std::vector<float> mX;
+        std::vector<float> mY;
+        std::vector<float> mPrevX;
+        std::vector<float> mPrevY;
+        std::vector<float> mW;
+        std::vector<float> mH;
+        std::vector<float> mVX;
+        std::vector<float> mVY;
+        std::vector<float> mLife;
+        std::vector<std::uint32_t> mOwner;
+        std::vector<ProjectileTeam> mTeam;
+        std::vector<std::uint32_t> mId;
+
+        AtlasRegion mSprite;
+        SDL_FRect mBounds{0.0f, 0.0f, 800.0f, 600.0f}; // one screen until SetBounds()
+
+        struct LaunchRequest {
+            ProjectileLauncher* launcher;
+            float x;
+            float y;
+            bool directionUp;
+            float minLaunchTime;
+            std::uint32_t order; // position in the queue, to break ties between one owner's shots
+        };
+
+        std::mutex mLaunchMutex;
+        std::vector<LaunchRequest> mLaunchQueue;
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+/**
+ * @brief Shelf bin-packer: places rectangles into fixed-size pages.
+ *
+ * Rectangles are sorted tallest-first and laid left to right on horizontal
+ * shelves; a new shelf opens below when a row fills up, and a new page opens
+ * when a page fills up. Simple, fast, and tight for sprite sets of similar height.
+ */
+class RectPacker {
+    public:
+        struct Placement {
+            int page{-1};   // -1 if the rectangle is larger than a page
+            SDL_Rect rect{0, 0, 0, 0};
+        };
+
+        /**
+         * @param pageWidth Width of each page in pixels.
+         * @param pageHeight Height of each page in pixels.
+         * @param padding Empty pixels kept around every rectangle to avoid sampling bleed.
+         */
+        RectPacker(int pageWidth, int pageHeight, int padding = 1);
+
+        /**
+         * @brief Packs rectangles of the given sizes.
+         *
+         * @param sizes w/h of each rectangle; x and y are ignored.
+         * @return One placement per input, in input order.
+         */
+        std::vector<Placement> Pack(const std::vector<SDL_Rect>& sizes);
+
+        /**
+         * @brief Number of pages used by the last Pack().
+         */
+        int GetPageCount() const { return mPageCount; }
+
+    private:
+        int mPageWidth;
+        int mPageHeight;
+        int mPadding;
+        int mPageCount{0};
+};
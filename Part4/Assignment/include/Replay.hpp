@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Everything besides the per-tick input that a replay needs to rebuild the
+ * same session: the RNG seed, the step rate and where the enemy waves came from.
+ */
+struct ReplaySettings {
+    std::uint32_t seed{1};
+    std::uint32_t checksumInterval{60};    // ticks between world checksums
+    float simulationRate{120.0f};
+    std::int32_t rows{3};                   // built-in waves, used when level is empty
+    std::int32_t columns{8};
+    std::int32_t waves{1};
+    std::int32_t scenarioTicks{1200};       // the built-in waves are spread over these
+    float enemyFireRate{1.0f};
+    float playerFireInterval{0.0f};         // headless auto-fire, 0 = none
+    char level[64]{};                       // .level file the session played, NUL-terminated
+};
+
+/**
+ * @brief 64-bit FNV-1a over raw bytes, for checksumming world state.
+ */
+struct StateHash {
+    std::uint64_t value{14695981039346656037ull};
+
+    void Add(const void* data, std::size_t size);
+
+    template <typename T>
+    void Add(const T& field) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        Add(&field, sizeof(T));
+    }
+};
+
+/**
+ * @brief Records a play session as per-tick input plus periodic world checksums,
+ * and plays one back.
+ *
+ * Input is stored only on the ticks where the held buttons change, so an idle
+ * minute costs nothing. While recording, Checksum() stores the world hash; while
+ * playing, it compares against the stored one and remembers the first tick that
+ * differs. The file is a small header followed by the input and checksum tables:
+ *
+ *   ReplayHeader, ReplayInput[inputCount], ReplayChecksum[checksumCount]
+ */
+class Replay {
+    public:
+        void BeginRecording(const ReplaySettings& settings);
+
+        /**
+         * @brief Notes the buttons held during `tick`. Ticks must come in order.
+         */
+        void RecordInput(std::uint32_t tick, std::uint8_t buttons);
+
+        /**
+         * @brief Writes the session so far (`tickCount` ticks) to `filePath`.
+         */
+        bool Save(const std::string& filePath, std::uint32_t tickCount) const;
+
+        /**
+         * @brief Reads a recorded session and gets ready to play it from tick 0.
+         */
+        bool Load(const std::string& filePath);
+
+        /**
+         * @brief Buttons held during `tick` of the session being played. Ticks must come in order.
+         */
+        std::uint8_t GetInput(std::uint32_t tick);
+
+        /**
+         * @brief Records the world checksum after `tick`, or checks it against the recording.
+         */
+        void Checksum(std::uint32_t tick, std::uint64_t value);
+
+        bool IsRecording() const { return mMode == Mode::Recording; }
+        bool IsPlaying() const { return mMode == Mode::Playing; }
+        bool IsActive() const { return mMode != Mode::Off; }
+
+        const ReplaySettings& GetSettings() const { return mSettings; }
+        std::uint32_t GetTickCount() const { return mTickCount; }
+
+        // Playback results
+        std::size_t GetChecksumsMatched() const { return mChecksumsMatched; }
+        bool HasDiverged() const { return mDiverged; }
+        std::uint32_t GetDivergedTick() const { return mDivergedTick; }
+        std::uint64_t GetExpectedChecksum() const { return mExpected; }
+        std::uint64_t GetActualChecksum() const { return mActual; }
+
+    private:
+        enum class Mode { Off, Recording, Playing };
+
+        struct Input {
+            std::uint32_t tick; // buttons held from this tick on
+            std::uint8_t buttons;
+            std::uint8_t padding[3];
+        };
+
+        struct Hash {
+            std::uint32_t tick;
+            std::uint32_t padding;
+            std::uint64_t value;
+        };
+
+        Mode mMode{Mode::Off};
+        ReplaySettings mSettings;
+        std::uint32_t mTickCount{0};
+        std::vector<Input> mInputs;
+        std::vector<Hash> mChecksums;
+
+        // Playback cursors into the tables above
+        std::size_t mNextInput{0};
+        std::size_t mNextChecksum{0};
+        std::uint8_t mButtons{0};
+
+        std::size_t mChecksumsMatched{0};
+        bool mDiverged{false};
+        std::uint32_t mDivergedTick{0};
+        std::uint64_t mExpected{0};
+        std::uint64_t mActual{0};
+};
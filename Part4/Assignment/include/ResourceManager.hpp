@@ -1,9 +1,35 @@
 #pragma once
 
 #include "SDL2/SDL.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <memory>
+#include <vector>
+
+/**
+ * @brief A rectangle of pixels within a texture: a whole texture, or one image in an atlas.
+ */
+struct AtlasRegion {
+    std::shared_ptr<SDL_Texture> texture;
+    SDL_Rect source{0, 0, 0, 0};
+};
+
+/**
+ * @brief Result slot for a texture load. Filled in on the main thread once the
+ * texture has been uploaded; until then `ready` is false and callers should draw
+ * a placeholder. Only ever read or written on the main thread.
+ */
+struct TextureRequest {
+    AtlasRegion region;
+    bool ready{false};
+    bool failed{false};
+};
+
+using TextureHandle = std::shared_ptr<TextureRequest>;
 
 class ResourceManager {
     public:
@@ -33,8 +59,96 @@ class ResourceManager {
          */
         std::shared_ptr<SDL_Texture> LoadTexture(SDL_Renderer* renderer, std::string filePath);
 
+        /**
+         * @brief Forgets every cached texture and atlas region, so the next request for
+         * any path loads it from disk again. Handles already given out stay valid.
+         */
+        void UnloadTextures();
+
+        /**
+         * @brief Packs a set of images into as few atlas textures as possible.
+         * 
+         * Each image is loaded, placed with a shelf bin-packer, and copied into a
+         * pageSize x pageSize page; each page becomes one texture. Afterwards
+         * LoadRegion() for any of these paths returns the shared atlas texture plus
+         * the image's rectangle within it, so sprites from the set can be batched
+         * into a single draw.
+         * 
+         * @param renderer The SDL_Renderer used to create the atlas textures.
+         * @param filePaths The images to pack. Images that fail to load are skipped.
+         * @param pageSize Width and height of each atlas page, in pixels.
+         * 
+         * @return The number of atlas pages created.
+         */
+        int BuildAtlas(SDL_Renderer* renderer, const std::vector<std::string>& filePaths, int pageSize = 1024);
+
+        /**
+         * @brief Returns the atlas region for an image, loading it as a standalone
+         * texture (whole-texture region) if it isn't part of any atlas.
+         * 
+         * @return The region, with a null texture if the image could not be loaded.
+         */
+        AtlasRegion LoadRegion(SDL_Renderer* renderer, std::string filePath);
+
+        /**
+         * @brief Starts loading a texture without blocking and returns its handle right away.
+         * 
+         * Cached textures and atlas images come back already ready. Otherwise a worker
+         * thread reads and decodes the file, and ProcessUploads() later creates the
+         * texture on the main thread. Asking for the same path again returns the same handle.
+         * 
+         * @param filePath The file path to the image file that needs to be loaded.
+         * 
+         * @return A handle that becomes ready (or failed) during a later ProcessUploads().
+         */
+        TextureHandle LoadTextureAsync(std::string filePath);
+
+        /**
+         * @brief Uploads decoded images to the GPU. Call once per frame on the render thread.
+         * 
+         * @param renderer The SDL_Renderer used to create the textures.
+         * @param budget The most textures to create this call, to keep frame time flat.
+         * 
+         * @return The number of handles completed.
+         */
+        int ProcessUploads(SDL_Renderer* renderer, int budget = 4);
+
+        /**
+         * @brief Stops the loader threads. Pending loads are dropped.
+         */
+        void StopLoaders();
+
+        /**
+         * @brief In headless mode nothing is read from disk: LoadTextureAsync() returns a
+         * null handle and LoadRegion() an empty region, so entities can be built without
+         * a renderer.
+         */
+        void SetHeadless(bool headless) { mHeadless = headless; }
+
     private:
+        struct DecodedImage {
+            std::string filePath;
+            SDL_Surface* surface;
+            std::string error; // why decoding failed; SDL keeps its error per thread
+        };
+
         ResourceManager() {}
+        void StartLoaders();
+        void LoaderThread();
+
         static ResourceManager* mInstance;
+        bool mHeadless{false};
         std::unordered_map<std::string, std::shared_ptr<SDL_Texture>> mTextures;
+        std::unordered_map<std::string, AtlasRegion> mRegions;
+
+        // Loads in flight, by path (main thread only)
+        std::unordered_map<std::string, TextureHandle> mPending;
+
+        // Shared with the loader threads, guarded by mLoaderMutex
+        std::mutex mLoaderMutex;
+        std::condition_variable mLoaderWake;
+        std::deque<std::string> mLoadQueue;
+        std::deque<DecodedImage> mDecoded;
+        bool mStopLoaders{false};
+        std::vector<std::thread> mLoaders;
 };
\ No newline at end of file
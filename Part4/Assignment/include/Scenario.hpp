@@ -0,0 +1,38 @@
+#pragma once
+
+#include <string>
+
+/**
+ * @brief Describes a scripted simulation run: how big each enemy wave is, how many
+ * waves to send and how hard everyone shoots.
+ *
+ * The defaults are the normal game (one 3x8 wave). A scenario file is plain text
+ * with one `key = value` per line; `#` starts a comment. Keys match the field
+ * names below (rows, columns, waves, ticks, enemy_fire_rate, player_fire_interval, level).
+ */
+struct Scenario {
+    int rows{3};
+    int columns{8};
+    int waves{1};                     // the run's ticks are split evenly between waves
+    int ticks{1200};                  // fixed simulation steps to run headless
+    float enemyFireRate{1.0f};        // multiplier on how often each enemy fires, > 0
+    float playerFireInterval{0.0f};   // ms between automatic player shots, 0 = never
+    std::string level;                // .level file whose waves replace rows/columns/waves
+
+    int EnemiesPerWave() const { return rows * columns; }
+};
+
+/**
+ * @brief Applies one `key=value` setting to a scenario.
+ *
+ * @return false if the key is unknown or the value isn't a positive number
+ * (or, for `level`, is empty).
+ */
+bool ApplyScenarioSetting(Scenario& scenario, const std::string& setting);
+
+/**
+ * @brief Reads a scenario file on top of the values already in `scenario`.
+ *
+ * @return false if the file can't be opened or has a bad line.
+ */
+bool LoadScenario(Scenario& scenario, const std::string& filePath);
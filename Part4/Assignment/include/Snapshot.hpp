@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Writes a world snapshot into a caller-owned byte buffer.
+ *
+ * A snapshot is a small versioned header followed by raw sections that the
+ * systems append in a fixed order, mostly whole arrays copied with one memcpy.
+ * The buffer is cleared but keeps its capacity, so capturing into the same
+ * buffer again doesn't allocate once it has grown to fit the world.
+ *
+ *   SnapshotHeader, then each system's sections in capture order
+ */
+class SnapshotWriter {
+    public:
+        SnapshotWriter(std::vector<std::byte>& buffer, std::uint32_t tick);
+
+        void WriteBytes(const void* data, std::size_t size);
+
+        template <typename T>
+        void Write(const T& value) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            WriteBytes(&value, sizeof(T));
+        }
+
+        template <typename T>
+        void WriteArray(const T* values, std::size_t count) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            WriteBytes(values, count * sizeof(T));
+        }
+
+        /**
+         * @brief Stamps the final size into the header. Call once, after the last section.
+         */
+        void Finish();
+
+    private:
+        std::vector<std::byte>& mBuffer;
+};
+
+/**
+ * @brief Reads back the sections of a snapshot in the order they were written.
+ *
+ * Every read is bounds-checked; the first one that would run past the end fails,
+ * and so does every read after it, so callers can check IsValid() once at the end.
+ */
+class SnapshotReader {
+    public:
+        /**
+         * @brief Checks the header. An unknown version or a size that doesn't match
+         * `data` leaves the reader invalid.
+         */
+        explicit SnapshotReader(std::span<const std::byte> data);
+
+        bool IsValid() const { return !mFailed; }
+
+        std::uint32_t GetTick() const { return mTick; }
+
+        std::size_t GetRemaining() const { return mData.size() - mOffset; }
+
+        bool ReadBytes(void* data, std::size_t size);
+
+        /**
+         * @brief Moves past `size` bytes without reading them, with the same bounds check as a read.
+         */
+        bool Skip(std::size_t size);
+
+        template <typename T>
+        bool Read(T& value) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            return ReadBytes(&value, sizeof(T));
+        }
+
+        template <typename T>
+        bool ReadArray(T* values, std::size_t count) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            return ReadBytes(values, count * sizeof(T));
+        }
+
+    private:
+        std::span<const std::byte> mData;
+        std::size_t mOffset{0};
+        std::uint32_t mTick{0};
+        bool mFailed{false};
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Uniform-grid broadphase keyed by hashed cell coordinates.
+ *
+ * Rectangles are inserted into every cell they overlap. A query returns the ids
+ * stored in the cells its rectangle overlaps, each id once. Those are only
+ * candidates (two cells can hash to the same bucket): callers still run the
+ * exact AABB test on them.
+ *
+ * Rebuild it every tick with Clear() followed by Insert(). Buckets are laid out
+ * flat with a counting sort on the first query after inserting, so a rebuild is
+ * linear in the number of entries and doesn't allocate once capacity settles.
+ */
+class SpatialHash {
+    public:
+        explicit SpatialHash(float cellSize = 64.0f);
+
+        /**
+         * @brief Removes every entry.
+         */
+        void Clear();
+
+        /**
+         * @brief Inserts `id` into each cell `rect` overlaps.
+         */
+        void Insert(std::uint32_t id, const SDL_FRect& rect);
+
+        /**
+         * @brief Lays out the buckets for querying. Query() does this on demand;
+         * calling it up front just moves the cost out of the first query.
+         */
+        void Build();
+
+        /**
+         * @brief Appends to `out` every id sharing a bucket with `rect`, each once, in ascending order.
+         */
+        void Query(const SDL_FRect& rect, std::vector<std::uint32_t>& out);
+
+        float GetCellSize() const { return mCellSize; }
+
+    private:
+        struct Entry {
+            std::uint32_t hash;
+            std::uint32_t id;
+        };
+
+        int CellCoord(float v) const;
+        static std::uint32_t CellHash(int cx, int cy);
+
+        float mCellSize;
+        float mInvCellSize;
+        bool mBuilt{true};
+
+        std::vector<Entry> mEntries;
+        std::uint32_t mBucketMask{0};
+        std::vector<std::uint32_t> mBucketStart; // mBucketMask + 2 offsets into mSortedIds
+        std::vector<std::uint32_t> mSortedIds;
+        std::vector<std::uint32_t> mCursor;
+
+        // Per-id stamp of the last query that reported it, for de-duplication
+        // of rectangles that span several cells.
+        std::vector<std::uint32_t> mQueryStamp;
+        std::uint32_t mCurrentStamp{0};
+};
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Draw order between groups of sprites. Lower layers are drawn first.
+enum class RenderLayer : std::uint8_t {
+    Background,
+    Entities,
+    Projectiles,
+    Overlay
+};
+
+/**
+ * @brief Per-frame command buffer of textured quads.
+ *
+ * Render code queues quads with Draw()/Fill() instead of calling SDL directly.
+ * Flush() sorts the queue by layer and then by texture, and submits each run of
+ * quads that share a texture as one SDL_RenderGeometry call. A thousand aliens
+ * that share Alien.bmp cost one draw call instead of a thousand.
+ *
+ * Within a layer, quads that share a texture keep their submission order. Quads
+ * with different textures in the same layer may be reordered.
+ */
+class SpriteBatch {
+    public:
+        explicit SpriteBatch(SDL_Renderer* renderer);
+
+        /**
+         * @brief Drops any queued quads, the translation and the scale. Call once at the start of the frame.
+         *
+         * @param interpolation How far this frame is between the previous and the
+         * current simulation step (0..1). Render code uses it to blend positions.
+         */
+        void Begin(float interpolation = 1.0f);
+
+        /**
+         * @brief Shifts every quad queued from now on by `offset`, e.g. to draw world
+         * positions into an offscreen layer whose top-left isn't the world's.
+         */
+        void SetTranslation(SDL_FPoint offset) { mTranslation = offset; }
+
+        /**
+         * @brief Scales every quad queued from now on by `scale`, after the translation
+         * (a camera's zoom).
+         */
+        void SetScale(float scale) { mScale = scale; }
+
+        /**
+         * @brief Queues the whole of `texture` stretched over `dst`.
+         */
+        void Draw(SDL_Texture* texture, const SDL_FRect& dst, RenderLayer layer = RenderLayer::Entities);
+
+        /**
+         * @brief Queues the `src` pixel rectangle of `texture` stretched over `dst`.
+         */
+        void Draw(SDL_Texture* texture, const SDL_Rect& src, const SDL_FRect& dst, RenderLayer layer = RenderLayer::Entities);
+
+        /**
+         * @brief Queues a solid colored quad.
+         */
+        void Fill(const SDL_FRect& dst, SDL_Color color, RenderLayer layer = RenderLayer::Entities);
+
+        /**
+         * @brief Sorts the queued quads and submits them to the renderer, then empties the queue.
+         */
+        void Flush();
+
+        SDL_Renderer* GetRenderer() const { return mRenderer; }
+
+        float GetInterpolation() const { return mInterpolation; }
+
+        /**
+         * @brief Number of SDL_RenderGeometry calls made by the last Flush().
+         */
+        std::size_t GetDrawCallCount() const { return mDrawCalls; }
+
+    private:
+        struct Command {
+            RenderLayer layer;
+            SDL_Texture* texture;
+            std::uint32_t order;
+            bool hasSource;
+            SDL_Rect src;
+            SDL_FRect dst;
+            SDL_Color color;
+        };
+
+        void Queue(SDL_Texture* texture, const SDL_Rect* src, const SDL_FRect& dst, SDL_Color color, RenderLayer layer);
+        void Submit(SDL_Texture* texture);
+
+        SDL_Renderer* mRenderer;
+        std::vector<Command> mCommands;
+        std::vector<SDL_Vertex> mVertices;
+        std::vector<int> mIndices;
+        std::size_t mDrawCalls{0};
+        float mInterpolation{1.0f};
+        SDL_FPoint mTranslation{0.0f, 0.0f};
+        float mScale{1.0f};
+};
@@ -12,7 +12,13 @@ class TextureComponent : public Component {
         ~TextureComponent();
     
         void CreateTextureComponent(SDL_Renderer* renderer, std::string filePath, float x = 0.0f, float y = 0.0f);
-        void Render(SDL_Renderer* renderer) override;
+
+        /**
+         * @brief Like CreateTextureComponent, but doesn't block on disk I/O. The component
+         * draws a placeholder until ResourceManager::ProcessUploads() finishes the texture.
+         */
+        void CreateTextureComponentAsync(std::string filePath);
+        void Render(SpriteBatch& batch) override;
     
         // These methods now delegate to the transform component
         void Move(float x, float y);
@@ -28,6 +34,8 @@ class TextureComponent : public Component {
         ComponentType GetType() override;
     
     private:
-        std::shared_ptr<SDL_Texture> mTexture;
+        // The texture (usually a shared atlas) and the part of it this sprite uses,
+        // once loaded
+        TextureHandle mTexture;
         // We no longer keep a rectangle here, it's in the transform component
     };
\ No newline at end of file
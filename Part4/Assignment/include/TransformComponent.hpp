@@ -9,11 +9,11 @@ public:
     TransformComponent();
     ~TransformComponent();
 
-    ComponentType GetType() override { return ComponentType::TransformComponent; }
+    ComponentType GetType() override { return ComponentTypeOf<TransformComponent>; }
 
     void Input(float deltaTime) override {}
     void Update(float deltaTime) override {}
-    void Render(SDL_Renderer* renderer) override {}
+    void Render(SpriteBatch& batch) override {}
 
     void Move(float dx, float dy);
     
@@ -29,6 +29,23 @@ public:
 
     SDL_FRect& GetRectangle();
 
+    /**
+     * @brief Remembers the current position as the start of the next simulation step.
+     */
+    void StorePrevious() { mPrevious = {mRectangle.x, mRectangle.y}; }
+
+    /**
+     * @brief Rectangle blended between the previous and current step.
+     *
+     * @param alpha 0 gives the previous step's position, 1 the current one.
+     */
+    SDL_FRect GetInterpolatedRectangle(float alpha) const {
+        return {mPrevious.x + (mRectangle.x - mPrevious.x) * alpha,
+                mPrevious.y + (mRectangle.y - mPrevious.y) * alpha,
+                mRectangle.w, mRectangle.h};
+    }
+
 private:
     SDL_FRect mRectangle;
+    SDL_FPoint mPrevious{0.0f, 0.0f};
 };
@@ -0,0 +1,162 @@
+#include "../include/AabbBatch.hpp"
+#include <bit>
+
+// The AVX2 kernel is built for its own target and picked at run time, so a build
+// without -mavx2 still uses it on CPUs that have it
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define AABB_AVX2_KERNEL __attribute__((target("avx2")))
+#elif defined(__AVX2__)
+#include <immintrin.h>
+#define AABB_AVX2_KERNEL
+#endif
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+void AabbSoA::Clear() {
+    x.clear();
+    y.clear();
+    w.clear();
+    h.clear();
+}
+
+void AabbSoA::Reserve(std::size_t count) {
+    x.reserve(count);
+    y.reserve(count);
+    w.reserve(count);
+    h.reserve(count);
+}
+
+void AabbSoA::Push(const SDL_FRect& rect) {
+    x.push_back(rect.x);
+    y.push_back(rect.y);
+    w.push_back(rect.w);
+    h.push_back(rect.h);
+}
+
+namespace {
+
+// The exact expression used by GameEntity::TestCollision, with `a` the query rectangle.
+inline bool Overlaps(const SDL_FRect& a, float bx, float by, float bw, float bh) {
+    return !(bx + bw <= a.x ||
+             a.x + a.w <= bx ||
+             by + bh <= a.y ||
+             a.y + a.h <= by);
+}
+
+// Each lane computes the four "separated" comparisons, ORs them, and inverts the
+// result. Keeping the <= form (instead of rewriting it as >) means NaNs behave
+// exactly as they do in the scalar predicate. Both kernels start at box `i`, fill
+// whole steps only, and return where they stopped.
+#if defined(AABB_AVX2_KERNEL)
+AABB_AVX2_KERNEL std::size_t MaskAvx2(const SDL_FRect& rect,
+                                      const float* x, const float* y, const float* w, const float* h,
+                                      std::size_t i, std::size_t count, std::uint64_t* mask) {
+    const __m256 ax = _mm256_set1_ps(rect.x);
+    const __m256 ay = _mm256_set1_ps(rect.y);
+    const __m256 ar = _mm256_set1_ps(rect.x + rect.w);
+    const __m256 ab = _mm256_set1_ps(rect.y + rect.h);
+    for (; i + 8 <= count; i += 8) {
+        const __m256 bx = _mm256_loadu_ps(x + i);
+        const __m256 by = _mm256_loadu_ps(y + i);
+        const __m256 br = _mm256_add_ps(bx, _mm256_loadu_ps(w + i));
+        const __m256 bb = _mm256_add_ps(by, _mm256_loadu_ps(h + i));
+
+        __m256 apart = _mm256_cmp_ps(br, ax, _CMP_LE_OQ);
+        apart = _mm256_or_ps(apart, _mm256_cmp_ps(ar, bx, _CMP_LE_OQ));
+        apart = _mm256_or_ps(apart, _mm256_cmp_ps(bb, ay, _CMP_LE_OQ));
+        apart = _mm256_or_ps(apart, _mm256_cmp_ps(ab, by, _CMP_LE_OQ));
+
+        const std::uint64_t bits = static_cast<std::uint64_t>(~_mm256_movemask_ps(apart) & 0xFF);
+        mask[i / 64] |= bits << (i % 64);
+    }
+    return i;
+}
+
+bool HasAvx2() {
+#if defined(__AVX2__)
+    return true;
+#else
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#endif
+}
+#endif
+
+#if defined(__SSE2__)
+std::size_t MaskSse2(const SDL_FRect& rect,
+                     const float* x, const float* y, const float* w, const float* h,
+                     std::size_t i, std::size_t count, std::uint64_t* mask) {
+    const __m128 ax = _mm_set1_ps(rect.x);
+    const __m128 ay = _mm_set1_ps(rect.y);
+    const __m128 ar = _mm_set1_ps(rect.x + rect.w);
+    const __m128 ab = _mm_set1_ps(rect.y + rect.h);
+    for (; i + 4 <= count; i += 4) {
+        const __m128 bx = _mm_loadu_ps(x + i);
+        const __m128 by = _mm_loadu_ps(y + i);
+        const __m128 br = _mm_add_ps(bx, _mm_loadu_ps(w + i));
+        const __m128 bb = _mm_add_ps(by, _mm_loadu_ps(h + i));
+
+        __m128 apart = _mm_cmple_ps(br, ax);
+        apart = _mm_or_ps(apart, _mm_cmple_ps(ar, bx));
+        apart = _mm_or_ps(apart, _mm_cmple_ps(bb, ay));
+        apart = _mm_or_ps(apart, _mm_cmple_ps(ab, by));
+
+        const std::uint64_t bits = static_cast<std::uint64_t>(~_mm_movemask_ps(apart) & 0xF);
+        mask[i / 64] |= bits << (i % 64);
+    }
+    return i;
+}
+#endif
+
+} // namespace
+
+void IntersectAabbMask(const SDL_FRect& rect,
+                       const float* x, const float* y, const float* w, const float* h,
+                       std::size_t count, std::uint64_t* mask) {
+    const std::size_t words = (count + 63) / 64;
+    for (std::size_t i = 0; i < words; ++i) {
+        mask[i] = 0;
+    }
+
+    std::size_t i = 0;
+#if defined(AABB_AVX2_KERNEL)
+    if (HasAvx2()) i = MaskAvx2(rect, x, y, w, h, i, count, mask);
+#endif
+#if defined(__SSE2__)
+    i = MaskSse2(rect, x, y, w, h, i, count, mask);
+#endif
+
+    for (; i < count; ++i) {
+        if (Overlaps(rect, x[i], y[i], w[i], h[i])) {
+            mask[i / 64] |= std::uint64_t{1} << (i % 64);
+        }
+    }
+}
+
+std::size_t IntersectAabbBatch(const SDL_FRect& rect, const AabbSoA& boxes, std::vector<std::uint32_t>& hits) {
+    const std::size_t count = boxes.Size();
+    const std::size_t before = hits.size();
+
+    // Work through the boxes in 512-box blocks so the mask lives on the stack.
+    constexpr std::size_t BlockSize = 512;
+    std::uint64_t mask[BlockSize / 64];
+
+    for (std::size_t base = 0; base < count; base += BlockSize) {
+        const std::size_t n = (count - base < BlockSize) ? count - base : BlockSize;
+        IntersectAabbMask(rect, boxes.x.data() + base, boxes.y.data() + base,
+                          boxes.w.data() + base, boxes.h.data() + base, n, mask);
+
+        for (std::size_t word = 0; word < (n + 63) / 64; ++word) {
+            std::uint64_t bits = mask[word];
+            while (bits) {
+                const int bit = std::countr_zero(bits);
+                hits.push_back(static_cast<std::uint32_t>(base + word * 64 + bit));
+                bits &= bits - 1;
+            }
+        }
+    }
+
+    return hits.size() - before;
+}
@@ -0,0 +1,115 @@
+#include "../include/Allocators.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+
+std::size_t AlignUp(std::size_t value, std::size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+} // namespace
+
+Arena::Arena(std::size_t blockSize) : mBlockSize(blockSize) {}
+
+Arena::~Arena() {
+    Reset();
+    std::free(mBlocks);
+}
+
+Arena::Block* Arena::NewBlock(std::size_t minimumSize) {
+    const std::size_t size = std::max(mBlockSize, minimumSize);
+    Block* block = static_cast<Block*>(std::malloc(sizeof(Block) + size));
+    if (!block) throw std::bad_alloc();
+
+    block->next = mBlocks;
+    block->size = size;
+    block->used = 0;
+    mBlocks = block;
+    return block;
+}
+
+void* Arena::Allocate(std::size_t size, std::size_t alignment) {
+    Block* block = mBlocks;
+    if (block) {
+        // Align the address, not the offset: block data is only max_align_t aligned
+        std::uintptr_t base = reinterpret_cast<std::uintptr_t>(DataOf(block));
+        std::size_t offset = AlignUp(base + block->used, alignment) - base;
+        if (offset + size <= block->size) {
+            block->used = offset + size;
+            mBytesUsed += size;
+            return DataOf(block) + offset;
+        }
+    }
+
+    block = NewBlock(size + alignment);
+    std::uintptr_t base = reinterpret_cast<std::uintptr_t>(DataOf(block));
+    std::size_t offset = AlignUp(base, alignment) - base;
+    block->used = offset + size;
+    mBytesUsed += size;
+    return DataOf(block) + offset;
+}
+
+void Arena::AddDestructor(void* object, void (*destroy)(void*)) {
+    auto* record = static_cast<Destructor*>(Allocate(sizeof(Destructor), alignof(Destructor)));
+    record->next = mDestructors;
+    record->destroy = destroy;
+    record->object = object;
+    mDestructors = record;
+}
+
+void Arena::Reset() {
+    for (Destructor* record = mDestructors; record; record = record->next) {
+        record->destroy(record->object);
+    }
+    mDestructors = nullptr;
+
+    // Keep the oldest block, which is the regular size unless the first allocation was huge
+    while (mBlocks && mBlocks->next) {
+        Block* next = mBlocks->next;
+        std::free(mBlocks);
+        mBlocks = next;
+    }
+    if (mBlocks) mBlocks->used = 0;
+    mBytesUsed = 0;
+}
+
+FrameAllocator::FrameAllocator(std::size_t capacity)
+    : mBuffer(static_cast<std::byte*>(std::malloc(capacity))), mCapacity(capacity) {
+    if (!mBuffer) throw std::bad_alloc();
+}
+
+FrameAllocator::~FrameAllocator() {
+    std::free(mBuffer);
+}
+
+void* FrameAllocator::Allocate(std::size_t size, std::size_t alignment) {
+    std::uintptr_t base = reinterpret_cast<std::uintptr_t>(mBuffer);
+    std::size_t offset = AlignUp(base + mUsed, alignment) - base;
+    if (offset + size <= mCapacity) {
+        mUsed = offset + size;
+        return mBuffer + offset;
+    }
+
+    // Out of room this tick: borrow from the heap and remember how much we needed
+    mOverflowBytes += size + alignment;
+    return mOverflow.Allocate(size, alignment);
+}
+
+void FrameAllocator::Reset() {
+    if (mOverflowBytes > 0) {
+        const std::size_t needed = mUsed + mOverflowBytes;
+        std::size_t capacity = mCapacity;
+        while (capacity < needed) capacity *= 2;
+
+        std::byte* buffer = static_cast<std::byte*>(std::malloc(capacity));
+        if (buffer) {
+            std::free(mBuffer);
+            mBuffer = buffer;
+            mCapacity = capacity;
+        }
+        mOverflow.Reset();
+        mOverflowBytes = 0;
+    }
+    mUsed = 0;
+}
@@ -1,183 +1,1206 @@
 // Application.cpp
 #include "../include/Application.hpp"
 #include "../include/ResourceManager.hpp"
+#include "../include/Log.hpp"
+#include "../include/Profiler.hpp"
+#include "../include/JobSystem.hpp"
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
 #include "InputComponent.hpp"
 
 Application::Application(int argc, char* argv[])
-    : mWindow(nullptr), mRenderer(nullptr), mRun(true), mFramesElapsed(0.0f) {}
+    : mWindow(nullptr), mRenderer(nullptr), mRun(true), mFramesElapsed(0.0f) {
+    std::string replayPath;
+    for (int i = 1; i < argc; ++i) {
+        bool ok = true;
+        if (std::strcmp(argv[i], "--headless") == 0) {
+            mHeadless = true;
+        } else if (std::strncmp(argv[i], "--threads=", 10) == 0) {
+            mWorkerThreads = std::atoi(argv[i] + 10);
+        } else if (std::strcmp(argv[i], "--profile") == 0) {
+            mPrintProfile = true;
+        } else if (std::strncmp(argv[i], "--trace=", 8) == 0) {
+            mTracePath = argv[i] + 8;
+        } else if (std::strncmp(argv[i], "--trace-frames=", 15) == 0) {
+            ok = std::sscanf(argv[i] + 15, "%llu,%llu", &mTraceFirstFrame, &mTraceFrameCount) == 2;
+            if (!ok) LOG_ERROR(Core, "Expected --trace-frames=FIRST,COUNT");
+        } else if (std::strncmp(argv[i], "--record=", 9) == 0) {
+            mRecordPath = argv[i] + 9;
+        } else if (std::strncmp(argv[i], "--replay=", 9) == 0) {
+            replayPath = argv[i] + 9;
+        } else if (std::strncmp(argv[i], "--seed=", 7) == 0) {
+            mSeed = static_cast<std::uint32_t>(std::strtoul(argv[i] + 7, nullptr, 10));
+        } else if (std::strncmp(argv[i], "--checksum-interval=", 20) == 0) {
+            mChecksumInterval = static_cast<std::uint32_t>(std::max(1, std::atoi(argv[i] + 20)));
+        } else if (std::strcmp(argv[i], "--snapshot-check") == 0) {
+            mSnapshotCheck = true;
+            mHeadless = true;
+        } else if (std::strncmp(argv[i], "--zoom=", 7) == 0) {
+            mZoom = static_cast<float>(std::atof(argv[i] + 7));
+            ok = mZoom > 0.0f;
+            if (!ok) LOG_ERROR(Core, "Expected --zoom=Z with Z above 0");
+        } else if (std::strncmp(argv[i], "--server=", 9) == 0) {
+            mNetMode = NetMode::Server;
+            mNetPort = static_cast<std::uint16_t>(std::atoi(argv[i] + 9));
+        } else if (std::strncmp(argv[i], "--connect=", 10) == 0) {
+            mNetMode = NetMode::Client;
+            ok = NetAddress::Parse(argv[i] + 10, mServerAddress);
+            if (!ok) LOG_ERROR(Net, "Expected --connect=HOST:PORT");
+        } else if (std::strncmp(argv[i], "--net-rate=", 11) == 0) {
+            mNetRate = std::max(1.0f, static_cast<float>(std::atof(argv[i] + 11)));
+        } else if (std::strncmp(argv[i], "--net-loss=", 11) == 0) {
+            mLinkConditions.lossPercent = static_cast<float>(std::atof(argv[i] + 11));
+        } else if (std::strncmp(argv[i], "--net-latency=", 14) == 0) {
+            mLinkConditions.latencyMs = static_cast<float>(std::atof(argv[i] + 14));
+        } else if (std::strncmp(argv[i], "--net-jitter=", 13) == 0) {
+            mLinkConditions.jitterMs = static_cast<float>(std::atof(argv[i] + 13));
+        } else if (std::strncmp(argv[i], "--net-bench=", 12) == 0) {
+            mNetBenchClients = std::clamp(std::atoi(argv[i] + 12), 1, NetMaxPlayers - 1);
+            mNetMode = NetMode::Server;
+            mHeadless = true;
+        } else if (std::strchr(argv[i], '=') != nullptr) {
+            ok = ApplyScenarioSetting(mScenario, argv[i]);
+        } else {
+            ok = LoadScenario(mScenario, argv[i]);
+        }
+
+        if (!ok) {
+            mRun = false;
+        }
+    }
+
+    if (mNetMode == NetMode::Client && mHeadless) {
+        // A client has nothing to run without a window; the server runs the game
+        LOG_ERROR(Net, "--connect needs a window");
+        mRun = false;
+    }
+
+    // A replay rebuilds the recorded session, whatever else the command line says
+    if (!replayPath.empty()) {
+        if (!mReplay.Load(replayPath)) {
+            mRun = false;
+            return;
+        }
+        const ReplaySettings& settings = mReplay.GetSettings();
+        mHeadless = true;
+        mNetMode = NetMode::Off;
+        mNetBenchClients = 0;
+        mSeed = settings.seed;
+        mChecksumInterval = settings.checksumInterval;
+        mSimulationRate = settings.simulationRate;
+        mScenario.rows = settings.rows;
+        mScenario.columns = settings.columns;
+        mScenario.waves = settings.waves;
+        mScenario.ticks = settings.scenarioTicks;
+        mScenario.enemyFireRate = settings.enemyFireRate;
+        mScenario.playerFireInterval = settings.playerFireInterval;
+        mScenario.level = settings.level;
+    }
+}
 
 Application::~Application() {
     ShutDown();
 }
 
 void Application::StartUp(char* argv[]) {
-    SDL_Init(SDL_INIT_VIDEO);
+    // Every enemy's fire timing comes from the spawn RNG, so the seed fixes the whole session
+    mSpawnRandom = mSeed ^ 0x9E3779B9u;
+    if (mSpawnRandom == 0) mSpawnRandom = 1;
+
+    if (!mTracePath.empty()) {
+        Profiler::Instance().RequestCapture(mTracePath, mTraceFirstFrame, mTraceFrameCount);
+    }
+
+    // One worker per spare core; the main thread works too while it waits
+    if (mWorkerThreads < 0) {
+        mWorkerThreads = std::max(0, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+    }
+    JobSystem::Instance().Start(mWorkerThreads);
+
+    if (mHeadless) {
+        // No window, no renderer, no textures: only the simulation runs
+        ResourceManager::Instance().SetHeadless(true);
+    } else {
+        SDL_Init(SDL_INIT_VIDEO);
+
+        mWindow = SDL_CreateWindow("Space Game", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, WindowWidth, WindowHeight, SDL_WINDOW_SHOWN);
+        mRenderer = SDL_CreateRenderer(mWindow, -1, SDL_RENDERER_ACCELERATED);
+        mSpriteBatch = std::make_unique<SpriteBatch>(mRenderer);
+        mFormationLayer = std::make_unique<CachedLayer>(mRenderer);
+
+        int width = WindowWidth;
+        int height = WindowHeight;
+        SDL_GetRendererOutputSize(mRenderer, &width, &height);
+        mCamera.SetViewport(static_cast<float>(width), static_cast<float>(height));
+        mCamera.SetZoom(mZoom);
+
+        // Pack all sprites into one atlas so every sprite draw can share a texture
+        ResourceManager::Instance().BuildAtlas(mRenderer, {
+            "Assets/Spaceship.bmp",
+            "Assets/Alien.bmp",
+            "Assets/Projectile.bmp"
+        }, 256);
+
+        mProjectiles.SetSprite(ResourceManager::Instance().LoadRegion(mRenderer, "Assets/Projectile.bmp"));
+    }
 
-    mWindow = SDL_CreateWindow("Space Game", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, 800, 600, SDL_WINDOW_SHOWN);
-    mRenderer = SDL_CreateRenderer(mWindow, -1, SDL_RENDERER_ACCELERATED);
+    if (mNetMode == NetMode::Client) {
+        // Join first: the server decides the level, the tick rate and our slot
+        mClient.SetConditions(mLinkConditions);
+        if (mClient.Connect(mServerAddress, NetTime())) {
+            const Clock::time_point giveUp = Clock::now() + std::chrono::seconds(3);
+            while (!mClient.IsConnected() && !mClient.WasRejected() && Clock::now() < giveUp) {
+                mClient.Receive(NetTime());
+                mClient.Flush(NetTime());
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        }
+        if (!mClient.IsConnected()) {
+            LOG_ERROR(Net, "Couldn't join the server");
+            mRun = false;
+            return;
+        }
+        const NetServerInfo& info = mClient.GetServerInfo();
+        mLocalSlot = info.slot;
+        mSimulationRate = info.simulationRate;
+        mScenario.level = info.level;
+    }
 
     // Create player and initialize components
-    mMainCharacter = std::make_shared<Player>(mRenderer);
+    mMainCharacter = std::make_unique<Player>(mProjectiles);
     
     // Add collision component to player
-    auto playerCollision = std::make_shared<Collision2DComponent>();
-    mMainCharacter->AddComponent(ComponentType::Collision2DComponent, playerCollision);
+    mMainCharacter->AddComponent(Collision2DComponent());
     
     // Initialize all components
     mMainCharacter->InitializeComponents();
     
     // Add input component
-    auto input = std::make_shared<InputComponent>();
-    mMainCharacter->AddComponent(ComponentType::InputComponent, input);
-    
-    // Initialize player projectile and add collision to it
-    if (mMainCharacter->GetProjectile()) {
-        auto projCollision = std::make_shared<Collision2DComponent>();
-        mMainCharacter->GetProjectile()->AddComponent(ComponentType::Collision2DComponent, projCollision);
-        mMainCharacter->GetProjectile()->InitializeComponents();
-    }
+    mMainCharacter->AddComponent(InputComponent());
 
     // Create enemies
-    for (int row = 0; row < 3; ++row) {
-        for (int col = 0; col < 8; ++col) {
-            // Create enemy
-            std::shared_ptr<Enemy> enemy = std::make_shared<Enemy>(mRenderer);
-            
-            // Add collision component to enemy
-            auto enemyCollision = std::make_shared<Collision2DComponent>();
-            enemy->AddComponent(ComponentType::Collision2DComponent, enemyCollision);
-            
-            // Initialize all components
-            enemy->InitializeComponents();
-            
-            // Position the enemy
-            float x = 60.0f + col * 80.0f;
-            float y = 60.0f + row * 60.0f;
-            
-            auto transform = enemy->GetTransform();
-            if (transform) {
-                transform->SetX(x);
-                transform->SetY(y);
-            }
-            
-            // Add collision to enemy projectile and initialize
-            if (enemy->GetProjectile()) {
-                auto projCollision = std::make_shared<Collision2DComponent>();
-                enemy->GetProjectile()->AddComponent(ComponentType::Collision2DComponent, projCollision);
-                enemy->GetProjectile()->InitializeComponents();
-            }
-            
-            mEnemies.push_back(enemy);
+    LoadLevel();
+    mProjectiles.SetBounds(mWorld);
+    mCamera.SetWorldBounds(mWorld);
+
+    // Start at the bottom, a little left of centre
+    TransformComponent& start = mMainCharacter->GetTransform();
+    start.SetX(mWorld.x + mWorld.w * 0.5f - 50.0f);
+    start.SetY(mWorld.y + mWorld.h - 100.0f);
+    start.StorePrevious();
+    if (!mWaves.empty() && mNetMode != NetMode::Client) {
+        // A client's waves come from the server's snapshots
+        SpawnWave(mWaves.front());
+        mNextWave = 1;
+    }
+
+    if (mNetMode == NetMode::Server && mRun) {
+        NetServerInfo info;
+        mNetSendInterval = static_cast<std::uint32_t>(std::clamp(std::lround(mSimulationRate / mNetRate), 1L, 255L));
+        info.sendInterval = static_cast<std::uint8_t>(mNetSendInterval);
+        info.simulationRate = mSimulationRate;
+        std::strncpy(info.level, mLevelPath.c_str(), sizeof(info.level) - 1);
+        mServer.SetConditions(mLinkConditions);
+        if (!mServer.Open(mNetPort, info)) {
+            mRun = false;
         }
-    }    
+    }
+
+    if (!mRecordPath.empty() && mNetMode != NetMode::Off) {
+        // Other players' input never reaches the recording, so it couldn't be replayed
+        LOG_WARN(Input, "Recording is off in network sessions");
+        mRecordPath.clear();
+    }
+
+    if (!mRecordPath.empty()) {
+        ReplaySettings settings;
+        settings.seed = mSeed;
+        settings.checksumInterval = mChecksumInterval;
+        settings.simulationRate = mSimulationRate;
+        settings.rows = mScenario.rows;
+        settings.columns = mScenario.columns;
+        settings.waves = mScenario.waves;
+        settings.scenarioTicks = mScenario.ticks;
+        settings.enemyFireRate = mScenario.enemyFireRate;
+        settings.playerFireInterval = mHeadless ? mScenario.playerFireInterval : 0.0f;
+        std::strncpy(settings.level, mLevelPath.c_str(), sizeof(settings.level) - 1);
+        mReplay.BeginRecording(settings);
+    }
+
+    // Size the narrowphase scratch up front so the first hits don't allocate mid-game
+    mCandidates.reserve(64);
+    mHits.reserve(64);
+    mCollisionEvents.reserve(64);
+    mCandidateBoxes.Reserve(64);
 }
 
-void Application::Input(float deltaTime) {
-    SDL_Event e;
-    const Uint8* keyState = SDL_GetKeyboardState(NULL);
+void Application::LoadLevel() {
+    std::string path = mScenario.level;
+    // A client plays whatever the server does, built-in waves included
+    if (path.empty() && !mHeadless && mNetMode != NetMode::Client) {
+        path = "levels/default.level";
+    }
 
-    while (SDL_PollEvent(&e)) {
-        if (e.type == SDL_QUIT) {
+    if (!path.empty()) {
+        Clock::time_point start = Clock::now();
+        if (mLevelFile.Open(path)) {
+            mPrefabs = mLevelFile.GetPrefabs();
+            mWaves = mLevelFile.GetWaves();
+            mLevelPath = path;
+            mWorld = {0.0f, 0.0f, mLevelFile.GetWorldWidth(), mLevelFile.GetWorldHeight()};
+            const double micros = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+            LOG_INFO(Resource, "Loaded level %s (%zu waves) in %.1f us", path.c_str(), mWaves.size(), micros);
+            return;
+        }
+        if (!mScenario.level.empty()) {
+            // Asked for by name, so don't quietly play something else
             mRun = false;
+            return;
         }
+        LOG_WARN(Resource, "Falling back to the built-in wave");
     }
 
+    // No level: build the scenario's waves, all the same grid, spread evenly over its ticks,
+    // in a world the size of the window
+    mWorld = {0.0f, 0.0f, LevelDefaultWorldWidth, LevelDefaultWorldHeight};
+    LevelPrefab alien{};
+    std::strncpy(alien.texture, "Assets/Alien.bmp", sizeof(alien.texture) - 1);
+    alien.width = 40.0f;
+    alien.height = 40.0f;
+    alien.minFireIntervalMs = 1000.0f;
+    alien.maxFireIntervalMs = 4000.0f;
+    mBuiltinPrefabs.assign(1, alien);
+
+    LevelWave wave{};
+    wave.columns = static_cast<std::uint16_t>(mScenario.columns);
+    wave.rows = static_cast<std::uint16_t>(mScenario.rows);
+    wave.originX = mWorld.x + 60.0f;
+    wave.originY = mWorld.y + 60.0f;
+    // Big waves are squeezed to fit between the margins, above the bottom 240 units
+    // where the player is, instead of spilling out of the world
+    wave.spacingX = std::min(80.0f, (mWorld.w - 120.0f) / mScenario.columns);
+    wave.spacingY = std::min(60.0f, (mWorld.h - 240.0f) / mScenario.rows);
+    wave.fireRate = 1.0f;
+    wave.ticks = static_cast<std::uint32_t>(std::max(1, mScenario.ticks / mScenario.waves));
+    mBuiltinWaves.assign(mScenario.waves, wave);
+    mBuiltinWaves.back().ticks = 0;
+
+    mPrefabs = mBuiltinPrefabs;
+    mWaves = mBuiltinWaves;
+}
+
+void Application::AdvanceWaves() {
+    if (mNextWave == 0 || mNextWave >= mWaves.size()) return;
+
+    // The next wave comes when the current one's time is up or it's been cleared
+    const LevelWave& current = mWaves[mNextWave - 1];
+    ++mWaveTicks;
+    if ((current.ticks > 0 && mWaveTicks >= current.ticks) || mEnemies.empty()) {
+        SpawnWave(mWaves[mNextWave++]);
+    }
+}
+
+void Application::SpawnWave(const LevelWave& wave) {
+    const LevelPrefab& prefab = mPrefabs[wave.prefab];
+    const std::span<const LevelSlot> slots = mLevelFile.GetSlots(wave);
+    const std::size_t count = slots.empty() ? static_cast<std::size_t>(wave.rows) * wave.columns : slots.size();
+    mWaveTicks = 0;
+    Enemy::sFireRate = mScenario.enemyFireRate * wave.fireRate;
+
+    // Survivors of the last wave give up their old slots
+    for (Enemy* enemy : mEnemies) {
+        enemy->LeaveFormation();
+    }
+
+    // A smaller wave than last time: park the leftover enemies for later waves
+    while (mEnemies.size() > count) {
+        KillEnemy(mEnemies.size() - 1);
+    }
+
+    // A bigger one: recycle dead enemies before building new ones
+    if (count > mEnemies.size() + mDeadEnemies.size()) {
+        ComponentStorage::Instance().Reserve<TransformComponent, TextureComponent, Collision2DComponent>(
+            count - mEnemies.size() - mDeadEnemies.size());
+    }
+    mEnemies.reserve(count);
+    while (mEnemies.size() < count) {
+        Enemy* enemy;
+        if (!mDeadEnemies.empty()) {
+            enemy = mDeadEnemies.back();
+            mDeadEnemies.pop_back();
+        } else {
+            enemy = CreateEnemy();
+        }
+        mEnemies.push_back(enemy);
+    }
+
+    // Every enemy can die this wave; make room up front so kills never allocate
+    mDeadEnemies.reserve(mEnemies.size() + mDeadEnemies.size());
+
+    mFormation.Reset(wave.columns, wave.rows, {wave.originX, wave.originY}, {wave.spacingX, wave.spacingY},
+                     {prefab.width, prefab.height});
+
+    // One texture component, copied to every enemy, so the lookup happens once per wave
+    TextureComponent texture;
+    texture.CreateTextureComponentAsync(prefab.texture);
+
+    for (std::size_t index = 0; index < count; ++index) {
+        const int col = slots.empty() ? static_cast<int>(index % wave.columns) : slots[index].column;
+        const int row = slots.empty() ? static_cast<int>(index / wave.columns) : slots[index].row;
+
+        // Position the enemy
+        Enemy* enemy = mEnemies[index];
+        enemy->Revive();
+        enemy->SetFireInterval(prefab.minFireIntervalMs, prefab.maxFireIntervalMs);
+        enemy->AddComponent(texture);
+        enemy->JoinFormation(mFormation, col, row);
+
+        const SDL_FPoint origin = mFormation.GetOrigin();
+        const SDL_FPoint offset = mFormation.GetOffset(col, row);
+        TransformComponent& transform = enemy->GetTransform();
+        transform.SetX(origin.x + offset.x);
+        transform.SetY(origin.y + offset.y);
+        transform.SetW(prefab.width);
+        transform.SetH(prefab.height);
+        transform.StorePrevious(); // appear in place, not sliding in from where it died
+    }
+}
+
+Enemy* Application::CreateEnemy() {
+    // Create enemy
+    Enemy* enemy = mEnemyPool.Create(mProjectiles, NextSpawnSeed());
+
+    // Add collision component to enemy
+    enemy->AddComponent(Collision2DComponent());
+
+    // Initialize all components
+    enemy->InitializeComponents();
+    return enemy;
+}
+
+std::uint32_t Application::NextSpawnSeed() {
+    mSpawnRandom ^= mSpawnRandom << 13;
+    mSpawnRandom ^= mSpawnRandom >> 17;
+    mSpawnRandom ^= mSpawnRandom << 5;
+    return mSpawnRandom;
+}
+
+void Application::KillEnemy(std::size_t index) {
+    Enemy* enemy = mEnemies[index];
+    enemy->SetRenderable(false);
+    enemy->LeaveFormation();
+    mDeadEnemies.push_back(enemy);
+
+    mEnemies[index] = mEnemies.back();
+    mEnemies.pop_back();
+}
+
+void Application::ClearLevel() {
+    for (Enemy* enemy : mEnemies) {
+        mEnemyPool.Destroy(enemy);
+    }
+    for (Enemy* enemy : mDeadEnemies) {
+        mEnemyPool.Destroy(enemy);
+    }
+    mEnemies.clear();
+    mDeadEnemies.clear();
+    mEnemyPool.Reset();
+    mLevelArena.Reset();
+    mWaves = {};
+    mPrefabs = {};
+    mNextWave = 0;
+    mLevelFile.Close();
+}
+
+void Application::Input(float deltaTime) {
+    PROFILE_SCOPE("Input");
+
+    std::uint8_t buttons = 0;
+    if (mReplay.IsPlaying()) {
+        buttons = mReplay.GetInput(mTick);
+    } else if (!mHeadless) {
+        SDL_Event e;
+        while (SDL_PollEvent(&e)) {
+            if (e.type == SDL_QUIT) {
+                mRun = false;
+            } else if (e.type == SDL_RENDER_TARGETS_RESET || e.type == SDL_RENDER_DEVICE_RESET) {
+                // The driver threw away what was drawn into our textures
+                mFormationLayer->Invalidate();
+            } else if (e.type == SDL_KEYDOWN && !e.key.repeat) {
+                if (e.key.keysym.scancode == SDL_SCANCODE_F5) {
+                    CaptureSnapshot(mQuickSave);
+                    LOG_INFO(Core, "Quick-saved tick %u (%zu bytes)", mTick, mQuickSave.size());
+                } else if (e.key.keysym.scancode == SDL_SCANCODE_F9) {
+                    if (mReplay.IsRecording() || mNetMode != NetMode::Off) {
+                        // The recording only has input, and the other players can't
+                        // jump back in time with us
+                        LOG_WARN(Core, "Quick-load is off while recording or in a network session");
+                    } else if (!mQuickSave.empty() && RestoreSnapshot(mQuickSave)) {
+                        LOG_INFO(Core, "Quick-loaded tick %u", mTick);
+                    }
+                }
+            }
+        }
+
+        const Uint8* keyState = SDL_GetKeyboardState(NULL);
+        if (keyState[SDL_SCANCODE_LEFT]) buttons |= InputLeft;
+        if (keyState[SDL_SCANCODE_RIGHT]) buttons |= InputRight;
+        if (keyState[SDL_SCANCODE_SPACE]) buttons |= InputFire;
+    }
+
+    if (mReplay.IsRecording()) {
+        mReplay.RecordInput(mTick, buttons);
+    }
+
+    if (mNetMode == NetMode::Client) {
+        mClient.SendInput(mTick, buttons, NetTime());
+        mInputHistory[mTick % mInputHistory.size()] = buttons;
+        // Movement is predicted here, but shots only exist once the server fires them
+        buttons &= static_cast<std::uint8_t>(~InputFire);
+    }
+
+    mMainCharacter->SetInputButtons(buttons);
     mMainCharacter->Input(deltaTime);
+
+    if (mNetMode == NetMode::Server) {
+        UpdateRemotePlayers(deltaTime);
+    }
+}
+
+void Application::UpdateRemotePlayers(float deltaTime) {
+    Clock::time_point start = Clock::now();
+    mServer.Receive(NetTime());
+    mNetMicros += std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+
+    for (int slot = 1; slot < NetMaxPlayers; ++slot) {
+        const bool connected = mServer.IsConnected(slot);
+        if (connected && !mRemotePlayers[slot]) {
+            AddRemotePlayer(slot);
+        } else if (!connected && mRemotePlayers[slot]) {
+            mRemotePlayers[slot].reset();
+        }
+
+        if (connected) {
+            mRemotePlayers[slot]->SetInputButtons(mServer.NextInput(slot));
+            mRemotePlayers[slot]->Input(deltaTime);
+        }
+    }
+}
+
+void Application::AddRemotePlayer(int slot) {
+    auto player = std::make_unique<Player>(mProjectiles);
+    player->AddComponent(Collision2DComponent());
+    player->InitializeComponents();
+    player->AddComponent(InputComponent());
+
+    TransformComponent& transform = player->GetTransform();
+    transform.SetX(mWorld.x + 20.0f + 48.0f * slot);
+    transform.SetY(mWorld.y + mWorld.h - 100.0f);
+    transform.StorePrevious();
+    mRemotePlayers[slot] = std::move(player);
+}
+
+double Application::NetTime() const {
+    // The benchmark runs faster than real time, so its links keep simulated time
+    if (mNetBenchClients > 0) {
+        return mTick * 1000.0 / mSimulationRate;
+    }
+    return std::chrono::duration<double, std::milli>(Clock::now() - mNetEpoch).count();
 }
 
 void Application::Update(float deltaTime) {
-    // Update player first
-    mMainCharacter->Update(deltaTime);
+    PROFILE_SCOPE("Update");
+    mFrameScratch.Reset();
+
+    if (mNetMode == NetMode::Client) {
+        UpdateClient(deltaTime);
+        return;
+    }
+
+    {
+        // Update players first
+        PROFILE_SCOPE("Update.Player");
+        ForEachPlayer([&](Player& player, int) { player.Update(deltaTime); });
+    }
+
+    MoveFormation(deltaTime);
+
+    {
+        // Enemies and projectiles don't touch each other's state, so both run at
+        // once across the workers. Enemies only read the pool's clock (advanced
+        // up front) and queue their shots, which launch after the pass.
+        PROFILE_SCOPE("Update.Entities");
+        JobSystem& jobs = JobSystem::Instance();
+        mProjectiles.AdvanceClock(deltaTime);
+
+        auto updateEnemies = [&](std::size_t begin, std::size_t end) {
+            PROFILE_SCOPE("Job.Enemies");
+            for (std::size_t i = begin; i < end; ++i) {
+                mEnemies[i]->Update(deltaTime);
+            }
+        };
+        auto moveProjectiles = [&](std::size_t begin, std::size_t end) {
+            PROFILE_SCOPE("Job.Projectiles");
+            mProjectiles.Integrate(begin, end, deltaTime);
+        };
+
+        JobCounter counter;
+        jobs.ParallelFor(mEnemies.size(), EnemyGrain, updateEnemies, counter);
+        jobs.ParallelFor(mProjectiles.Size(), ProjectileGrain, moveProjectiles, counter);
+        jobs.Wait(counter);
+
+        mProjectiles.RemoveExpired();
+        mProjectiles.FlushLaunches();
+    }
+
+    BuildBroadphase();
+    DetectCollisions();
+    HandleCollisionEvents();
+    ApplyDestroyRequests();
+    AdvanceWaves();
+
+    ++mTick;
+    if (mReplay.IsActive() && mTick % mChecksumInterval == 0) {
+        mReplay.Checksum(mTick, ComputeChecksum());
+    }
+
+    if (mNetMode == NetMode::Server) {
+        Clock::time_point start = Clock::now();
+        if (mTick % mNetSendInterval == 0) {
+            SendWorldState();
+        }
+        mServer.Flush(NetTime());
+        mNetMicros += std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    }
+}
 
-    // Then update all enemies
-    for (auto& enemy : mEnemies) {
-        enemy->Update(deltaTime);
+void Application::SendWorldState() {
+    NetWorldState& state = mNetState;
+    state.tick = mTick;
+    state.wave = static_cast<std::uint16_t>(mNextWave);
+
+    if (mNextWave > 0) {
+        const LevelWave& wave = mWaves[mNextWave - 1];
+        state.prefab = static_cast<std::uint8_t>(wave.prefab);
+        state.spacingX = QuantizePosition(wave.spacingX);
+        state.spacingY = QuantizePosition(wave.spacingY);
+        state.ResetSlots(wave.columns, wave.rows);
+    } else {
+        state.ResetSlots(0, 0);
     }
 
-    // Group bounce detection - check if ANY enemy has reached the edge
-    bool shouldReverse = false;
-    for (auto& enemy : mEnemies) {
-        if (!enemy->GetRenderable()) continue;
-        
-        auto transform = enemy->GetTransform();
-        if (!transform) continue;
+    // Every live enemy sits in a slot of the current wave; the rest of the slots are empty
+    std::fill(state.alive.begin(), state.alive.end(), 0);
+    for (Enemy* enemy : mEnemies) {
+        if (enemy->IsInFormation()) {
+            state.SetAlive(static_cast<std::size_t>(enemy->GetRow()) * state.columns + enemy->GetColumn());
+        }
+    }
+    const SDL_FPoint origin = mFormation.GetOrigin();
+    state.originX = QuantizePosition(origin.x);
+    state.originY = QuantizePosition(origin.y);
+    state.moveRight = Enemy::sMoveRight;
+
+    state.players.fill({});
+    ForEachPlayer([&](Player& player, int slot) {
+        const TransformComponent& transform = player.GetTransform();
+        state.players[slot] = {QuantizePosition(transform.GetX()), QuantizePosition(transform.GetY()), true,
+                               player.GetRenderable()};
+    });
+
+    state.projectiles.clear();
+    for (std::uint32_t i = 0; i < mProjectiles.Size(); ++i) {
+        const SDL_FRect rect = mProjectiles.GetRectangle(i);
+        state.projectiles.push_back({mProjectiles.GetProjectileId(i), QuantizePosition(rect.x),
+                                     QuantizePosition(rect.y), mTick, mProjectiles.GetTeam(i)});
+    }
+    std::sort(state.projectiles.begin(), state.projectiles.end(),
+              [](const NetProjectile& a, const NetProjectile& b) { return a.id < b.id; });
+
+    mServer.SendSnapshots(state, NetTime());
+}
+
+void Application::UpdateClient(float deltaTime) {
+    PROFILE_SCOPE("Update.Client");
+
+    if (mClient.Receive(NetTime())) {
+        ApplyWorldState(mClient.GetState());
+    }
+
+    // Between snapshots the world carries on the way the server would move it
+    ForEachPlayer([&](Player& player, int) { player.Update(deltaTime); });
+    MoveFormation(deltaTime);
+    for (Enemy* enemy : mEnemies) {
+        enemy->SnapToFormation();
+    }
+    mProjectiles.Update(deltaTime);
+
+    ++mTick;
+    mClient.Flush(NetTime());
+}
+
+void Application::ApplyWorldState(const NetWorldState& state) {
+    PROFILE_SCOPE("Update.ApplyWorldState");
+
+    // A new wave: build its full grid, then hide the slots that are empty
+    if (!mHasClientWave || state.wave != mClientWave) {
+        LevelWave wave{};
+        wave.prefab = std::min<std::uint32_t>(state.prefab, static_cast<std::uint32_t>(mPrefabs.size() - 1));
+        wave.columns = state.columns;
+        wave.rows = state.rows;
+        wave.originX = DequantizePosition(state.originX);
+        wave.originY = DequantizePosition(state.originY);
+        wave.spacingX = DequantizePosition(state.spacingX);
+        wave.spacingY = DequantizePosition(state.spacingY);
+        wave.fireRate = 1.0f;
+        SpawnWave(wave);
+        mSlotEnemies.assign(mEnemies.begin(), mEnemies.end());
+        mHasClientWave = true;
+        mClientWave = state.wave;
+    }
 
-        float x = transform->GetX();
-        float w = transform->GetW();
-        
-        if (x < 10.0f || x + w > 790.0f) {
-            std::cout << "Enemy at edge: x=" << x << ", w=" << w << ", right edge=" << (x + w) << std::endl;
-            shouldReverse = true;
-            break;
+    for (std::size_t slot = 0; slot < mSlotEnemies.size(); ++slot) {
+        Enemy* enemy = mSlotEnemies[slot];
+        if (!state.IsAlive(slot) && enemy->IsInFormation()) {
+            enemy->SetRenderable(false);
+            enemy->LeaveFormation();
         }
     }
+    mFormation.SetOrigin({DequantizePosition(state.originX), DequantizePosition(state.originY)});
+    Enemy::sMoveRight = state.moveRight;
+
+    for (int slot = 0; slot < NetMaxPlayers; ++slot) {
+        const NetPlayerState& player = state.players[slot];
+        if (slot == mLocalSlot) continue;
+        if (!player.connected) {
+            mRemotePlayers[slot].reset();
+            continue;
+        }
+        if (!mRemotePlayers[slot]) {
+            AddRemotePlayer(slot);
+        }
+        TransformComponent& transform = mRemotePlayers[slot]->GetTransform();
+        transform.SetX(DequantizePosition(player.x));
+        transform.SetY(DequantizePosition(player.y));
+        mRemotePlayers[slot]->SetRenderable(player.alive);
+    }
+
+    // Our own ship: the server's position plus the input it hadn't used yet. Without
+    // an ack the server hasn't moved us at all, and too old a one can't be replayed.
+    const NetPlayerState& local = state.players[mLocalSlot];
+    TransformComponent& transform = mMainCharacter->GetTransform();
+    if (mClient.HasInputAck()) {
+        const std::uint32_t ack = mClient.GetInputAck();
+        float x = DequantizePosition(local.x);
+        if (mTick - ack < mInputHistory.size()) {
+            const float step = 1.0f / mSimulationRate;
+            for (std::uint32_t tick = ack + 1; tick != mTick + 1; ++tick) {
+                x += InputComponent::MoveX(mInputHistory[tick % mInputHistory.size()], step);
+            }
+        }
+        transform.SetX(x);
+    }
+    transform.SetY(DequantizePosition(local.y));
+    mMainCharacter->SetRenderable(local.alive);
+
+    // Projectiles fly straight, so each is placed where it has got to by this state's tick
+    while (mProjectiles.Size() > 0) {
+        mProjectiles.Despawn(mProjectiles.Size() - 1);
+    }
+    for (const NetProjectile& projectile : state.projectiles) {
+        const float vy = projectile.team == ProjectileTeam::Player ? -ProjectilePool::Speed : ProjectilePool::Speed;
+        const float elapsed = static_cast<float>(state.tick - projectile.tick) / mSimulationRate;
+        mProjectiles.Spawn(DequantizePosition(projectile.x), DequantizePosition(projectile.y) + vy * elapsed, 0.0f,
+                           vy, 0, projectile.team);
+    }
+}
+
+std::uint64_t Application::ComputeChecksum() {
+    StateHash hash;
+    hash.Add(mTick);
+
+    const TransformComponent& player = mMainCharacter->GetTransform();
+    hash.Add(player.GetX());
+    hash.Add(player.GetY());
+    hash.Add(mMainCharacter->GetRenderable());
+
+    hash.Add(Enemy::sMoveRight);
+    hash.Add(mFormation.GetOrigin());
+    hash.Add(mEnemies.size());
+    for (Enemy* enemy : mEnemies) {
+        const TransformComponent& transform = enemy->GetTransform();
+        hash.Add(transform.GetX());
+        hash.Add(transform.GetY());
+    }
+
+    hash.Add(mProjectiles.GetTicks());
+    hash.Add(mProjectiles.Size());
+    for (std::uint32_t i = 0; i < mProjectiles.Size(); ++i) {
+        hash.Add(mProjectiles.GetRectangle(i));
+        hash.Add(mProjectiles.GetTeam(i));
+    }
+    return hash.value;
+}
+
+void Application::CaptureSnapshot(std::vector<std::byte>& buffer) {
+    SnapshotWriter writer(buffer, mTick);
 
-    // If any enemy has reached the edge, reverse direction for all
-    if (shouldReverse) {
-        std::cout << "REVERSING ENEMY DIRECTION - was moving " 
-                 << (Enemy::sMoveRight ? "right" : "left") << std::endl;
+    // Where in the level we are; the wave count keeps a snapshot out of other levels
+    writer.Write(static_cast<std::uint32_t>(mWaves.size()));
+    writer.Write(static_cast<std::uint32_t>(mNextWave));
+    writer.Write(mWaveTicks);
+    writer.Write(mSpawnRandom);
+    writer.Write(Enemy::sMoveRight);
+    writer.Write(Enemy::sFireRate);
+
+    writer.Write(mMainCharacter->GetTransform().GetRectangle());
+    writer.Write(mMainCharacter->GetRenderable());
+    writer.Write(mMainCharacter->GetLauncher());
+    writer.Write(mMainCharacter->GetInputButtons());
+
+    mFormation.SaveState(writer);
+
+    // Live enemies, then dead ones, so restoring rebuilds both lists in the same order
+    writer.Write(static_cast<std::uint32_t>(mEnemies.size()));
+    writer.Write(static_cast<std::uint32_t>(mDeadEnemies.size()));
+    EnemyState state{};
+    for (Enemy* enemy : mEnemies) {
+        enemy->SaveState(state);
+        writer.Write(state);
+    }
+    for (Enemy* enemy : mDeadEnemies) {
+        enemy->SaveState(state);
+        writer.Write(state);
+    }
+
+    mProjectiles.SaveState(writer);
+    writer.Finish();
+}
+
+bool Application::RestoreSnapshot(std::span<const std::byte> snapshot) {
+    SnapshotReader reader(snapshot);
+
+    std::uint32_t waveCount = 0;
+    std::uint32_t nextWave = 0;
+    std::uint32_t waveTicks = 0;
+    std::uint32_t spawnRandom = 0;
+    bool moveRight = true;
+    float fireRate = 1.0f;
+    reader.Read(waveCount);
+    reader.Read(nextWave);
+    reader.Read(waveTicks);
+    reader.Read(spawnRandom);
+    reader.Read(moveRight);
+    reader.Read(fireRate);
+
+    SDL_FRect player{};
+    bool playerRenderable = true;
+    ProjectileLauncher playerLauncher;
+    std::uint8_t playerButtons = 0;
+    reader.Read(player);
+    reader.Read(playerRenderable);
+    reader.Read(playerLauncher);
+    reader.Read(playerButtons);
+
+    if (!reader.IsValid()) return false;
+    if (waveCount != mWaves.size() || nextWave > waveCount) {
+        LOG_ERROR(Core, "Snapshot is from another level (%u waves, this one has %zu)", waveCount, mWaves.size());
+        return false;
+    }
+
+    // Walk every remaining section with a second reader first, so a damaged snapshot
+    // is turned away before anything below has changed the world
+    std::uint32_t liveCount = 0;
+    std::uint32_t deadCount = 0;
+    SnapshotReader check = reader;
+    bool ok = Formation::SkipState(check) && check.Read(liveCount) && check.Read(deadCount);
+    const std::size_t total = static_cast<std::size_t>(liveCount) + deadCount;
+    ok = ok && check.Skip(total * sizeof(EnemyState)) && mProjectiles.SkipState(check) &&
+         check.GetRemaining() == 0;
+    if (!ok) {
+        LOG_ERROR(Core, "Snapshot is damaged");
+        return false;
+    }
+
+    mFormation.LoadState(reader);
+    reader.Skip(sizeof(liveCount) + sizeof(deadCount));
+
+    // Snapshots don't name enemy objects, so any will do: reuse the ones there are,
+    // build what's missing, and free the extras so that enemies built after this
+    // point come from the restored spawn RNG, just like the first time around
+    mEnemies.insert(mEnemies.end(), mDeadEnemies.begin(), mDeadEnemies.end());
+    mDeadEnemies.clear();
+    bool rebuilt = false;
+    while (mEnemies.size() > total) {
+        mEnemyPool.Destroy(mEnemies.back());
+        mEnemies.pop_back();
+    }
+    while (mEnemies.size() < total) {
+        mEnemies.push_back(CreateEnemy());
+        rebuilt = true;
+    }
+    mDeadEnemies.assign(mEnemies.begin() + liveCount, mEnemies.end());
+    mEnemies.resize(liveCount);
+    mDeadEnemies.reserve(total);
+
+    EnemyState state{};
+    for (Enemy* enemy : mEnemies) {
+        reader.Read(state);
+        enemy->LoadState(state, mFormation);
+    }
+    for (Enemy* enemy : mDeadEnemies) {
+        reader.Read(state);
+        enemy->LoadState(state, mFormation);
+    }
+
+    // Live enemies wear their wave's sprite; only a different wave or new enemies need it set again
+    if ((rebuilt || nextWave != mNextWave) && nextWave > 0) {
+        TextureComponent texture;
+        texture.CreateTextureComponentAsync(mPrefabs[mWaves[nextWave - 1].prefab].texture);
+        for (Enemy* enemy : mEnemies) {
+            enemy->AddComponent(texture);
+        }
+    }
+
+    mProjectiles.LoadState(reader);
+
+    mTick = reader.GetTick();
+    mNextWave = nextWave;
+    mWaveTicks = waveTicks;
+    mSpawnRandom = spawnRandom;
+    Enemy::sMoveRight = moveRight;
+    Enemy::sFireRate = fireRate;
+
+    TransformComponent& transform = mMainCharacter->GetTransform();
+    transform.GetRectangle() = player;
+    transform.StorePrevious();
+    mMainCharacter->SetRenderable(playerRenderable);
+    mMainCharacter->SetLauncher(playerLauncher);
+    mMainCharacter->SetInputButtons(playerButtons);
+    return true;
+}
+
+void Application::MoveFormation(float deltaTime) {
+    PROFILE_SCOPE("Update.Formation");
+
+    // The whole block moves by moving its origin; enemies snap to their slots in
+    // their own update, which runs after this.
+    mFormation.Move((Enemy::sMoveRight ? 1.0f : -1.0f) * mEnemySpeed * deltaTime, 0.0f);
+    if (mFormation.IsEmpty()) return;
+
+    // Group bounce: the live bounds are kept up to date as enemies die, so
+    // checking whether any enemy reached the edge doesn't visit them
+    const SDL_FRect bounds = mFormation.GetBounds();
+    if (bounds.x < mWorld.x + FormationEdgeMargin || bounds.x + bounds.w > mWorld.x + mWorld.w - FormationEdgeMargin) {
+        LOG_DEBUG(Enemy, "Reversing enemy direction - was moving %s (formation x=%.1f, w=%.1f)",
+                  Enemy::sMoveRight ? "right" : "left", bounds.x, bounds.w);
         Enemy::sMoveRight = !Enemy::sMoveRight;
-        
+
         // Move enemies down when they reverse direction
-        for (auto& enemy : mEnemies) {
-            if (!enemy->GetRenderable()) continue;
-            auto transform = enemy->GetTransform();
-            if (transform) {
-                transform->Move(0.0f, 10.0f); // Move down 10 pixels
+        mFormation.Move(0.0f, 10.0f); // Move down 10 pixels
+    }
+}
+
+void Application::BuildBroadphase() {
+    PROFILE_SCOPE("Update.Broadphase");
+    JobSystem& jobs = JobSystem::Instance();
+
+    // Snap every collision rectangle to its transform. This walks each
+    // archetype's packed arrays in order instead of visiting entities one by one.
+    ComponentStorage::Instance().ForEachArchetype(
+        SignatureOf(ComponentTypeOf<TransformComponent>) | SignatureOf(ComponentTypeOf<Collision2DComponent>),
+        [&](Archetype& archetype) {
+            TransformComponent* transforms = archetype.Data<TransformComponent>();
+            Collision2DComponent* collisions = archetype.Data<Collision2DComponent>();
+            jobs.ParallelFor(archetype.Size(), RowGrain, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; ++i) {
+                    collisions[i].GetRectangle() = transforms[i].GetRectangle();
+                }
+            });
+        });
+
+    // Broadphase: bin live enemies and live enemy projectiles by grid cell.
+    // Enemy ids are indices into mEnemies, projectile ids are pool indices.
+    // The two grids are independent, so each is built on its own thread.
+    auto buildEnemyGrid = [&] {
+        PROFILE_SCOPE("Job.EnemyGrid");
+        mEnemyGrid.Clear();
+        for (std::uint32_t i = 0; i < mEnemies.size(); ++i) {
+            mEnemyGrid.Insert(i, mEnemies[i]->GetComponent<Collision2DComponent>().GetRectangle());
+        }
+        mEnemyGrid.Build();
+    };
+
+    auto buildProjectileGrid = [&] {
+        PROFILE_SCOPE("Job.ProjectileGrid");
+        mEnemyProjectileGrid.Clear();
+        for (std::uint32_t i = 0; i < mProjectiles.Size(); ++i) {
+            if (mProjectiles.GetTeam(i) == ProjectileTeam::Enemy) {
+                mEnemyProjectileGrid.Insert(i, mProjectiles.GetRectangle(i));
             }
         }
+        mEnemyProjectileGrid.Build();
+    };
+
+    JobCounter counter;
+    jobs.Run(buildEnemyGrid, counter);
+    jobs.Run(buildProjectileGrid, counter);
+    jobs.Wait(counter);
+}
+
+void Application::DetectCollisions() {
+    PROFILE_SCOPE("Update.Narrowphase");
+
+    // Narrowphase: pack the broadphase candidates and test them in one batch.
+    // Every overlap becomes an event; nothing is removed here, so a shot
+    // reports all the enemies it touches and the order of tests doesn't matter.
+    mCollisionEvents.clear();
+    for (std::uint32_t p = 0; p < mProjectiles.Size(); ++p) {
+        if (mProjectiles.GetTeam(p) != ProjectileTeam::Player) continue;
+
+        const SDL_FRect shot = mProjectiles.GetRectangle(p);
+        mCandidates.clear();
+        mEnemyGrid.Query(shot, mCandidates);
+
+        mCandidateBoxes.Clear();
+        for (std::uint32_t i : mCandidates) {
+            mCandidateBoxes.Push(mEnemies[i]->GetComponent<Collision2DComponent>().GetRectangle());
+        }
+
+        mHits.clear();
+        IntersectAabbBatch(shot, mCandidateBoxes, mHits);
+        for (std::uint32_t hit : mHits) {
+            mCollisionEvents.push_back({p, mCandidates[hit], CollisionLayer::PlayerProjectile, CollisionLayer::Enemy,
+                                        ContactPoint(shot, mCandidateBoxes, hit)});
+        }
     }
 
-    // Collision detection using Collision2DComponent
-    std::shared_ptr<Projectile> playerProj = mMainCharacter->GetProjectile();
-    if (playerProj->GetRenderable()) {
-        for (auto& enemy : mEnemies) {
-            if (enemy->GetRenderable() &&
-                playerProj->TestCollision(enemy)) {
-                std::cout << "Collision detected! Removing enemy.\n";
-                enemy->SetRenderable(false);
-                playerProj->SetRenderable(false);
+    ForEachPlayer([&](Player& player, int slot) {
+        const SDL_FRect& rect = player.GetComponent<Collision2DComponent>().GetRectangle();
+        mCandidates.clear();
+        mEnemyProjectileGrid.Query(rect, mCandidates);
+
+        mCandidateBoxes.Clear();
+        for (std::uint32_t i : mCandidates) {
+            mCandidateBoxes.Push(mProjectiles.GetRectangle(i));
+        }
+
+        mHits.clear();
+        IntersectAabbBatch(rect, mCandidateBoxes, mHits);
+        for (std::uint32_t hit : mHits) {
+            mCollisionEvents.push_back({static_cast<std::uint32_t>(slot), mCandidates[hit], CollisionLayer::Player,
+                                        CollisionLayer::EnemyProjectile, ContactPoint(rect, mCandidateBoxes, hit)});
+        }
+    });
+}
+
+SDL_FPoint Application::ContactPoint(const SDL_FRect& rect, const AabbSoA& boxes, std::size_t index) {
+    const float left = std::max(rect.x, boxes.x[index]);
+    const float top = std::max(rect.y, boxes.y[index]);
+    const float right = std::min(rect.x + rect.w, boxes.x[index] + boxes.w[index]);
+    const float bottom = std::min(rect.y + rect.h, boxes.y[index] + boxes.h[index]);
+    return {(left + right) * 0.5f, (top + bottom) * 0.5f};
+}
+
+void Application::HandleCollisionEvents() {
+    PROFILE_SCOPE("Update.CollisionResponse");
+
+    mEnemyDestroyFlags = mFrameScratch.AllocateArray<std::uint8_t>(mEnemies.size());
+    mProjectileDestroyFlags = mFrameScratch.AllocateArray<std::uint8_t>(mProjectiles.Size());
+    std::fill(mEnemyDestroyFlags.begin(), mEnemyDestroyFlags.end(), 0);
+    std::fill(mProjectileDestroyFlags.begin(), mProjectileDestroyFlags.end(), 0);
+    mDestroyPlayers = 0;
+
+    // Events are in detection order (shots by pool index, then enemies by candidate
+    // order), so the same contacts always resolve the same way.
+    for (const CollisionEvent& event : mCollisionEvents) {
+        switch (event.layerA) {
+            case CollisionLayer::PlayerProjectile: {
+                // One projectile, one kill, and an enemy already hit this frame
+                // lets the next shot through to whatever is behind it
+                if (mProjectileDestroyFlags[event.a] || mEnemyDestroyFlags[event.b]) break;
+                LOG_TRACE(Collision, "Shot %u hit enemy %u at (%.1f, %.1f)", event.a, event.b, event.contact.x, event.contact.y);
+                mProjectileDestroyFlags[event.a] = 1;
+                mEnemyDestroyFlags[event.b] = 1;
                 break;
             }
+            case CollisionLayer::Player:
+                LOG_TRACE(Collision, "Player %u hit at (%.1f, %.1f)", event.a, event.contact.x, event.contact.y);
+                mProjectileDestroyFlags[event.b] = 1;
+                mDestroyPlayers |= 1u << event.a;
+                break;
+            default:
+                break;
         }
     }
-    
-    for (auto& enemy : mEnemies) {
-        std::shared_ptr<Projectile> enemyProj = enemy->GetProjectile();
-        if (enemyProj->GetRenderable() &&
-            enemyProj->TestCollision(mMainCharacter)) {
-            mMainCharacter->SetRenderable(false);
-            enemyProj->SetRenderable(false);
+}
+
+void Application::ApplyDestroyRequests() {
+    PROFILE_SCOPE("Update.Destroy");
+
+    // Highest index first, so each swap-and-pop only moves an enemy that survives
+    for (std::size_t i = mEnemyDestroyFlags.size(); i-- > 0;) {
+        if (mEnemyDestroyFlags[i]) {
+            KillEnemy(i);
+        }
+    }
+
+    ForEachPlayer([&](Player& player, int slot) {
+        if (mDestroyPlayers & (1u << slot)) {
+            player.SetRenderable(false);
         }
+    });
+
+    // Despawn from the highest index down so each swap-remove only moves
+    // projectiles we're already done with.
+    for (std::size_t p = mProjectileDestroyFlags.size(); p-- > 0;) {
+        if (mProjectileDestroyFlags[p]) {
+            mProjectiles.Despawn(static_cast<std::uint32_t>(p));
+        }
+    }
+
+    mEnemyDestroyFlags = {};
+    mProjectileDestroyFlags = {};
+    mDestroyPlayers = 0;
+}
+
+void Application::StorePreviousState() {
+    ComponentStorage::Instance().ForEachArchetype(
+        SignatureOf(ComponentTypeOf<TransformComponent>),
+        [](Archetype& archetype) {
+            TransformComponent* transforms = archetype.Data<TransformComponent>();
+            for (std::size_t row = 0; row < archetype.Size(); ++row) {
+                transforms[row].StorePrevious();
+            }
+        });
+
+    mProjectiles.StorePrevious();
+    mFormation.StorePrevious();
+}
+
+bool Application::UpdateFormationLayer() {
+    PROFILE_SCOPE("Render.Layers");
+
+    const SDL_FPoint extent = mFormation.GetExtent();
+    if (!mFormationLayer->Reserve(static_cast<int>(std::ceil(extent.x)), static_cast<int>(std::ceil(extent.y)))) {
+        return false;
+    }
+
+    if (mFormation.GetVersion() != mFormationLayerVersion) {
+        mFormationLayer->Invalidate();
+        mFormationLayerVersion = mFormation.GetVersion();
     }
+
+    // Every live enemy sits in its formation slot, so the layer is drawn relative to the origin
+    mFormationLayer->Redraw(*mSpriteBatch, mFormation.GetOrigin(), [&] {
+        for (Enemy* enemy : mEnemies) {
+            enemy->Render(*mSpriteBatch);
+        }
+    });
+    return true;
 }
 
-void Application::Render() {
+void Application::Render(float interpolation) {
+    PROFILE_SCOPE("Render");
+
+    {
+        // Finish a few background texture loads, without letting a new wave spike the frame
+        PROFILE_SCOPE("Render.Uploads");
+        if (ResourceManager::Instance().ProcessUploads(mRenderer) > 0) {
+            // An enemy sprite that was still loading may be on the cached formation
+            mFormationLayer->Invalidate();
+        }
+    }
+
+    // Before the frame starts: a redraw renders into the layer's own target
+    const bool formationCached = UpdateFormationLayer();
+
     SDL_SetRenderDrawColor(mRenderer, 0, 0, 0, 255);
     SDL_RenderClear(mRenderer);
 
-    mMainCharacter->Render(mRenderer);
+    {
+        // Everything is queued first and drawn in a few texture-sorted batches
+        PROFILE_SCOPE("Render.Queue");
+
+        // Keep the local player in view, where it's drawn this frame
+        const SDL_FRect focus = mMainCharacter->GetTransform().GetInterpolatedRectangle(interpolation);
+        mCamera.Follow({focus.x + focus.w * 0.5f, focus.y + focus.h * 0.5f});
+        const SDL_FRect& view = mCamera.GetView();
 
-    for (auto& enemy : mEnemies) {
-        enemy->Render(mRenderer);
+        mSpriteBatch->Begin(interpolation);
+        mSpriteBatch->SetTranslation({-view.x, -view.y});
+        mSpriteBatch->SetScale(mCamera.GetZoom());
+
+        // Culling: anything entirely outside the view is skipped
+        ForEachPlayer([&](Player& player, int) {
+            if (mCamera.IsVisible(player.GetTransform().GetInterpolatedRectangle(interpolation))) {
+                player.Render(*mSpriteBatch);
+            }
+        });
+
+        if (formationCached) {
+            const SDL_FPoint origin = mFormation.GetInterpolatedOrigin(interpolation);
+            const SDL_FPoint extent = mFormation.GetExtent();
+            if (mCamera.IsVisible({origin.x, origin.y, extent.x, extent.y})) {
+                mFormationLayer->Composite(*mSpriteBatch, origin);
+            }
+        } else {
+            for (auto& enemy : mEnemies) {
+                if (mCamera.IsVisible(enemy->GetTransform().GetInterpolatedRectangle(interpolation))) {
+                    enemy->Render(*mSpriteBatch);
+                }
+            }
+        }
+
+        mProjectiles.Render(*mSpriteBatch, view);
     }
 
-    SDL_RenderPresent(mRenderer);
+    {
+        PROFILE_SCOPE("Render.Flush");
+        mSpriteBatch->Flush();
+    }
+
+    {
+        PROFILE_SCOPE("Render.Present");
+        SDL_RenderPresent(mRenderer);
+    }
 }
 
 void Application::Loop(float targetFPS) {
-    float targetFrameTime = 1.0f / targetFPS;
+    float targetFrameTime = targetFPS > 0.0f ? 1.0f / targetFPS : 0.0f;
+    const float step = 1.0f / mSimulationRate;
+    float accumulator = 0.0f;
     auto lastTime = std::chrono::high_resolution_clock::now();
 
     while (mRun) {
+        Profiler::Instance().BeginFrame();
         auto currentTime = std::chrono::high_resolution_clock::now();
         float deltaTime = std::chrono::duration<float>(currentTime - lastTime).count();
         lastTime = currentTime;
+        accumulator += deltaTime;
 
-        Input(deltaTime);
-        Update(deltaTime);
-        Render();
+        int steps = 0;
+        while (accumulator >= step && steps < MaxStepsPerFrame) {
+            StorePreviousState();
+            Input(step);
+            Update(step);
+            accumulator -= step;
+            ++steps;
+        }
+
+        // Too far behind to catch up: drop the backlog instead of paying for it next frame
+        if (steps == MaxStepsPerFrame && accumulator >= step) {
+            LOG_DEBUG(Core, "Simulation fell behind, dropping %.1f ms", accumulator * 1000.0f);
+            accumulator = 0.0f;
+        }
+
+        Render(accumulator / step);
+        Profiler::Instance().EndFrame();
 
         float frameTime = std::chrono::duration<float>(
             std::chrono::high_resolution_clock::now() - currentTime).count();
@@ -188,8 +1211,279 @@ void Application::Loop(float targetFPS) {
     }
 }
 
+void Application::AutoFire() {
+    if (mScenario.playerFireInterval > 0.0f) {
+        const TransformComponent& transform = mMainCharacter->GetTransform();
+        mMainCharacter->Launch(transform.GetX() + transform.GetW() / 2.0f - 3.0f,
+                               transform.GetY() - 5.0f, mScenario.playerFireInterval);
+    }
+}
+
+void Application::RunScenario() {
+    if (!mRun) return;
+
+    const float step = 1.0f / mSimulationRate;
+
+    std::size_t firstWave = 0;
+    if (!mWaves.empty()) {
+        const LevelWave& wave = mWaves.front();
+        firstWave = wave.slotCount > 0 ? wave.slotCount : static_cast<std::size_t>(wave.columns) * wave.rows;
+    }
+    std::printf("Scenario: %zu waves, %zu enemies in the first, %d ticks at %.0f Hz\n",
+                mWaves.size(), firstWave, mScenario.ticks, mSimulationRate);
+
+    std::size_t peakProjectiles = 0;
+    Clock::time_point start = Clock::now();
+    for (int tick = 0; tick < mScenario.ticks; ++tick) {
+        AutoFire();
+
+        Profiler::Instance().BeginFrame();
+        Update(step);
+        Profiler::Instance().EndFrame();
+        peakProjectiles = std::max(peakProjectiles, mProjectiles.Size());
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::printf("Ran %d ticks in %.3f s: %.1f ticks/sec (%.3f ms/tick)\n",
+                mScenario.ticks, seconds, mScenario.ticks / seconds, seconds * 1000.0 / mScenario.ticks);
+
+    Profiler::Instance().Report(stdout);
+    std::size_t enemiesAlive = mEnemies.size();
+    std::printf("Peak projectiles in flight: %zu, enemies alive at the end: %zu\n", peakProjectiles, enemiesAlive);
+}
+
+bool Application::RunReplay() {
+    if (!mRun) return false;
+
+    const float step = 1.0f / mSimulationRate;
+    const std::uint32_t ticks = mReplay.GetTickCount();
+    const ReplaySettings& settings = mReplay.GetSettings();
+    std::printf("Replaying %u ticks (seed %u, %s) at %.0f Hz\n", ticks, settings.seed,
+                settings.level[0] ? settings.level : "built-in waves", mSimulationRate);
+
+    Clock::time_point start = Clock::now();
+    for (std::uint32_t tick = 0; tick < ticks; ++tick) {
+        // Same stand-in fire as RunScenario, for sessions recorded headless
+        AutoFire();
+
+        Profiler::Instance().BeginFrame();
+        Input(step);
+        Update(step);
+        Profiler::Instance().EndFrame();
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::printf("Ran %u ticks in %.3f s: %.1f ticks/sec (%.3f ms/tick)\n",
+                ticks, seconds, ticks / seconds, seconds * 1000.0 / std::max<std::uint32_t>(1, ticks));
+    Profiler::Instance().Report(stdout);
+
+    if (mReplay.HasDiverged()) {
+        std::printf("Replay DIVERGED at tick %u: expected checksum %016llx, got %016llx\n",
+                    mReplay.GetDivergedTick(),
+                    static_cast<unsigned long long>(mReplay.GetExpectedChecksum()),
+                    static_cast<unsigned long long>(mReplay.GetActualChecksum()));
+        return false;
+    }
+    std::printf("Replay matched all %zu checksums\n", mReplay.GetChecksumsMatched());
+    return true;
+}
+
+bool Application::RunSnapshotCheck() {
+    if (!mRun) return false;
+
+    const float step = 1.0f / mSimulationRate;
+    const int first = mScenario.ticks / 2;
+    const int rest = mScenario.ticks - first;
+    auto run = [&](int ticks) {
+        for (int tick = 0; tick < ticks; ++tick) {
+            AutoFire();
+            Profiler::Instance().BeginFrame();
+            Update(step);
+            Profiler::Instance().EndFrame();
+        }
+    };
+
+    run(first);
+    const std::uint64_t captured = ComputeChecksum();
+    const std::size_t enemies = mEnemies.size() + mDeadEnemies.size();
+    const std::size_t projectiles = mProjectiles.Size();
+    std::vector<std::byte> snapshot;
+    CaptureSnapshot(snapshot);
+
+    // Capturing again reuses the buffer and restoring the snapshot just taken changes
+    // nothing, so both can be timed over a few rounds
+    constexpr int Rounds = 50;
+    Clock::time_point start = Clock::now();
+    for (int round = 0; round < Rounds; ++round) {
+        CaptureSnapshot(snapshot);
+    }
+    const double captureMicros = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / Rounds;
+
+    bool restored = true;
+    start = Clock::now();
+    for (int round = 0; round < Rounds; ++round) {
+        restored = RestoreSnapshot(snapshot) && restored;
+    }
+    const double restoreMicros = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / Rounds;
+    const bool sameAfterRestore = ComputeChecksum() == captured;
+
+    run(rest);
+    const std::uint64_t original = ComputeChecksum();
+    restored = RestoreSnapshot(snapshot) && restored;
+    run(rest);
+    const std::uint64_t replayed = ComputeChecksum();
+
+    std::printf("Snapshot at tick %d: %zu bytes, %zu enemies, %zu projectiles\n",
+                first, snapshot.size(), enemies, projectiles);
+    std::printf("Capture %.1f us, restore %.1f us (average of %d)\n", captureMicros, restoreMicros, Rounds);
+
+    const bool ok = restored && sameAfterRestore && original == replayed;
+    if (!ok) {
+        std::printf("Snapshot check FAILED: restore %s, checksum after restore %s, %d ticks on %016llx vs %016llx\n",
+                    restored ? "ok" : "failed", sameAfterRestore ? "matched" : "differed", rest,
+                    static_cast<unsigned long long>(original), static_cast<unsigned long long>(replayed));
+        return false;
+    }
+    std::printf("Snapshot check passed: %d ticks after the restore matched the original run\n", rest);
+    return true;
+}
+
+void Application::RunServer() {
+    if (!mRun) return;
+
+    const float step = 1.0f / mSimulationRate;
+    const auto stepDuration = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(step));
+    std::printf("Serving %d ticks at %.0f Hz on UDP port %u, snapshots every %u ticks\n", mScenario.ticks,
+                mSimulationRate, static_cast<unsigned>(mServer.GetPort()), mNetSendInterval);
+
+    // Real time, unlike RunScenario: the clients play along at the same rate
+    double clientSeconds = 0.0;
+    Clock::time_point next = Clock::now();
+    for (int tick = 0; tick < mScenario.ticks && mRun; ++tick) {
+        AutoFire();
+
+        Profiler::Instance().BeginFrame();
+        Input(step);
+        Update(step);
+        Profiler::Instance().EndFrame();
+        clientSeconds += mServer.GetClientCount() * static_cast<double>(step);
+
+        next += stepDuration;
+        std::this_thread::sleep_until(next);
+    }
+
+    const double bytes = static_cast<double>(mServer.GetBytesSent() + mServer.GetPacketsSent() * NetPacketOverhead);
+    std::printf("Sent %llu packets, %.1f KB: %.2f KB/s per client on average\n",
+                static_cast<unsigned long long>(mServer.GetPacketsSent()), bytes / 1024.0,
+                clientSeconds > 0.0 ? bytes / 1024.0 / clientSeconds : 0.0);
+}
+
+bool Application::RunNetBench() {
+    if (!mRun) return false;
+
+    const float step = 1.0f / mSimulationRate;
+    std::printf("Net bench: %d clients, %d ticks at %.0f Hz, snapshots every %u ticks, %.0f%% loss, %.0f+%.0f ms latency\n",
+                mNetBenchClients, mScenario.ticks, mSimulationRate, mNetSendInterval, mLinkConditions.lossPercent,
+                mLinkConditions.latencyMs, mLinkConditions.jitterMs);
+
+    // The clients are real sockets on loopback, but only the network side of a
+    // client: each checks every state it rebuilds against what the server sent
+    const NetAddress server{0x7F000001, mServer.GetPort()};
+    std::vector<std::unique_ptr<NetClient>> bots;
+    for (int i = 0; i < mNetBenchClients; ++i) {
+        auto bot = std::make_unique<NetClient>();
+        bot->SetConditions(mLinkConditions);
+        if (!bot->Connect(server, NetTime())) return false;
+        bots.push_back(std::move(bot));
+    }
+
+    std::size_t matched = 0;
+    std::size_t unchecked = 0;
+    std::size_t mismatched = 0;
+    double serverMicros = 0.0;
+    Clock::time_point start = Clock::now();
+    for (int tick = 0; tick < mScenario.ticks; ++tick) {
+        const double now = NetTime();
+        for (std::size_t i = 0; i < bots.size(); ++i) {
+            NetClient& bot = *bots[i];
+            if (bot.Receive(now)) {
+                const NetWorldState& state = bot.GetState();
+                const NetWorldState* sent = mServer.FindSent(bot.GetServerInfo().slot, state.sequence);
+                if (!sent) {
+                    ++unchecked;
+                } else if (*sent == state) {
+                    ++matched;
+                } else {
+                    ++mismatched;
+                }
+            }
+            // Hold fire and sweep from side to side, each client out of step with the others
+            const bool left = ((mTick + i * 37) / 120) % 2 != 0;
+            bot.SendInput(mTick, static_cast<std::uint8_t>(InputFire | (left ? InputLeft : InputRight)), now);
+            bot.Flush(now);
+        }
+
+        AutoFire();
+
+        Clock::time_point tickStart = Clock::now();
+        Profiler::Instance().BeginFrame();
+        Input(step);
+        Update(step);
+        Profiler::Instance().EndFrame();
+        serverMicros += std::chrono::duration<double, std::micro>(Clock::now() - tickStart).count();
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    int joined = 0;
+    std::uint64_t upBytes = 0;
+    std::uint64_t downBytes = 0;
+    for (const auto& bot : bots) {
+        joined += bot->IsConnected() ? 1 : 0;
+        upBytes += bot->GetBytesSent() + bot->GetPacketsSent() * NetPacketOverhead;
+        downBytes += bot->GetBytesReceived();
+    }
+    const double sentBytes = static_cast<double>(mServer.GetBytesSent() + mServer.GetPacketsSent() * NetPacketOverhead);
+    const double simulatedSeconds = mScenario.ticks * static_cast<double>(step);
+    const double clients = static_cast<double>(bots.size());
+
+    std::printf("Ran %d ticks in %.3f s; server %.3f ms/tick, of which network %.1f us (%.1f us per client)\n",
+                mScenario.ticks, seconds, serverMicros / 1000.0 / mScenario.ticks, mNetMicros / mScenario.ticks,
+                mNetMicros / mScenario.ticks / clients);
+    std::printf("Per client: %.2f KB/s down (%.2f KB/s of it arrived, headers not counted), %.2f KB/s up, UDP/IP headers included\n",
+                sentBytes / 1024.0 / simulatedSeconds / clients, downBytes / 1024.0 / simulatedSeconds / clients,
+                upBytes / 1024.0 / simulatedSeconds / clients);
+    Profiler::Instance().Report(stdout);
+
+    const bool ok = joined == mNetBenchClients && mismatched == 0;
+    std::printf("%d of %d clients joined; %zu states matched what the server sent, %zu mismatched, %zu too old to check\n",
+                joined, mNetBenchClients, matched, mismatched, unchecked);
+    if (!ok) {
+        std::printf("Net bench FAILED\n");
+    }
+    return ok;
+}
+
 void Application::ShutDown() {
-    SDL_DestroyRenderer(mRenderer);
-    SDL_DestroyWindow(mWindow);
+    JobSystem::Instance().Stop();
+    if (mNetMode == NetMode::Client) {
+        mClient.Disconnect(NetTime());
+    }
+    mServer.Close();
+    if (mReplay.IsRecording() && !mRecordPath.empty()) {
+        mReplay.Save(mRecordPath, mTick);
+        mRecordPath.clear();
+    }
+    ClearLevel();
+    if (mPrintProfile) {
+        Profiler::Instance().Report(stdout);
+        mPrintProfile = false;
+    }
+    ResourceManager::Instance().StopLoaders();
+    mFormationLayer.reset();
+    if (mRenderer) SDL_DestroyRenderer(mRenderer);
+    if (mWindow) SDL_DestroyWindow(mWindow);
+    mRenderer = nullptr;
+    mWindow = nullptr;
     SDL_Quit();
+    Logger::Instance().Stop();
 }
\ No newline at end of file
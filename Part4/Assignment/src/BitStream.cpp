@@ -0,0 +1,73 @@
+#include "../include/BitStream.hpp"
+#include <cstring>
+
+BitWriter::BitWriter(std::uint8_t* buffer, std::size_t capacityBytes)
+    : mBuffer(buffer), mCapacityBits(capacityBytes * 8) {
+    std::memset(mBuffer, 0, capacityBytes);
+}
+
+void BitWriter::WriteBits(std::uint32_t value, int count) {
+    if (mOverflowed || static_cast<std::size_t>(count) > mCapacityBits - mBits) {
+        mOverflowed = true;
+        return;
+    }
+
+    // Fill the current byte, then whole bytes
+    while (count > 0) {
+        const int used = static_cast<int>(mBits & 7);
+        const int take = count < 8 - used ? count : 8 - used;
+        mBuffer[mBits >> 3] |= static_cast<std::uint8_t>((value & ((1u << take) - 1)) << used);
+        value >>= take;
+        count -= take;
+        mBits += take;
+    }
+}
+
+void BitWriter::WriteVarUint(std::uint32_t value) {
+    while (value >= 0x80) {
+        WriteBits((value & 0x7F) | 0x80, 8);
+        value >>= 7;
+    }
+    WriteBits(value, 8);
+}
+
+void BitWriter::WriteVarInt(std::int32_t value) {
+    WriteVarUint((static_cast<std::uint32_t>(value) << 1) ^ static_cast<std::uint32_t>(value >> 31));
+}
+
+BitReader::BitReader(const std::uint8_t* data, std::size_t sizeBytes)
+    : mData(data), mSizeBits(sizeBytes * 8) {}
+
+std::uint32_t BitReader::ReadBits(int count) {
+    if (mOverflowed || static_cast<std::size_t>(count) > mSizeBits - mBits) {
+        mOverflowed = true;
+        return 0;
+    }
+
+    std::uint32_t value = 0;
+    int shift = 0;
+    while (count > 0) {
+        const int used = static_cast<int>(mBits & 7);
+        const int take = count < 8 - used ? count : 8 - used;
+        value |= static_cast<std::uint32_t>((mData[mBits >> 3] >> used) & ((1u << take) - 1)) << shift;
+        shift += take;
+        count -= take;
+        mBits += take;
+    }
+    return value;
+}
+
+std::uint32_t BitReader::ReadVarUint() {
+    std::uint32_t value = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        const std::uint32_t byte = ReadBits(8);
+        value |= (byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) break;
+    }
+    return value;
+}
+
+std::int32_t BitReader::ReadVarInt() {
+    const std::uint32_t zigzag = ReadVarUint();
+    return static_cast<std::int32_t>((zigzag >> 1) ^ (0u - (zigzag & 1)));
+}
@@ -0,0 +1,66 @@
+#include "../include/CachedLayer.hpp"
+#include "../include/Log.hpp"
+#include <algorithm>
+
+CachedLayer::CachedLayer(SDL_Renderer* renderer) : mRenderer(renderer) {
+    mSupported = SDL_RenderTargetSupported(renderer);
+    SDL_RendererInfo info{};
+    if (SDL_GetRendererInfo(renderer, &info) == 0) {
+        mMaxWidth = info.max_texture_width;
+        mMaxHeight = info.max_texture_height;
+    }
+    if (!mSupported) {
+        LOG_WARN(Resource, "Renderer can't draw into textures; cached layers are drawn directly");
+    }
+}
+
+CachedLayer::~CachedLayer() {
+    if (mTexture) SDL_DestroyTexture(mTexture);
+}
+
+bool CachedLayer::Reserve(int width, int height) {
+    if (!mSupported || width <= 0 || height <= 0) return false;
+    if (mTexture && width <= mWidth && height <= mHeight) return true;
+    if ((mMaxWidth > 0 && width > mMaxWidth) || (mMaxHeight > 0 && height > mMaxHeight)) return false;
+
+    // Never shrink, so a layer that changes size a little doesn't reallocate every time
+    const int newWidth = std::max(width, mWidth);
+    const int newHeight = std::max(height, mHeight);
+    SDL_Texture* texture = SDL_CreateTexture(mRenderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                                             newWidth, newHeight);
+    if (!texture) {
+        LOG_ERROR(Resource, "Failed to create a %dx%d layer: %s", newWidth, newHeight, SDL_GetError());
+        return false;
+    }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+    if (mTexture) SDL_DestroyTexture(mTexture);
+    mTexture = texture;
+    mWidth = newWidth;
+    mHeight = newHeight;
+    mDirty = true;
+    return true;
+}
+
+void CachedLayer::BeginRedraw(SpriteBatch& batch, SDL_FPoint origin) {
+    SDL_SetRenderTarget(mRenderer, mTexture);
+    SDL_SetRenderDrawColor(mRenderer, 0, 0, 0, 0);
+    SDL_RenderClear(mRenderer);
+
+    // Drawn as of the current step; the composite is what moves between steps
+    batch.Begin(1.0f);
+    batch.SetTranslation({-origin.x, -origin.y});
+}
+
+void CachedLayer::EndRedraw(SpriteBatch& batch) {
+    batch.Flush();
+    batch.SetTranslation({0.0f, 0.0f});
+    SDL_SetRenderTarget(mRenderer, nullptr);
+    mDirty = false;
+    ++mRedraws;
+}
+
+void CachedLayer::Composite(SpriteBatch& batch, SDL_FPoint position, RenderLayer layer) {
+    if (!mTexture) return;
+    batch.Draw(mTexture, {position.x, position.y, static_cast<float>(mWidth), static_cast<float>(mHeight)}, layer);
+}
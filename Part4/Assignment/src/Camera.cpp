@@ -0,0 +1,42 @@
+#include "../include/Camera.hpp"
+#include <algorithm>
+
+void Camera::SetViewport(float width, float height) {
+    mViewport = {width, height};
+    SetZoom(mZoom);
+}
+
+void Camera::SetWorldBounds(const SDL_FRect& bounds) {
+    mWorld = bounds;
+    Clamp();
+}
+
+void Camera::SetZoom(float zoom) {
+    if (!(zoom > 0.0f)) return;
+
+    // Zoom about the centre of the view
+    const SDL_FPoint centre{mView.x + mView.w * 0.5f, mView.y + mView.h * 0.5f};
+    mZoom = zoom;
+    mView.w = mViewport.x / mZoom;
+    mView.h = mViewport.y / mZoom;
+    Follow(centre);
+}
+
+void Camera::SetPosition(SDL_FPoint position) {
+    mView.x = position.x;
+    mView.y = position.y;
+    Clamp();
+}
+
+void Camera::Follow(SDL_FPoint target) {
+    SetPosition({target.x - mView.w * 0.5f, target.y - mView.h * 0.5f});
+}
+
+void Camera::Clamp() {
+    auto clampAxis = [](float position, float size, float worldStart, float worldSize) {
+        if (size >= worldSize) return worldStart + (worldSize - size) * 0.5f;
+        return std::clamp(position, worldStart, worldStart + worldSize - size);
+    };
+    mView.x = clampAxis(mView.x, mView.w, mWorld.x, mWorld.w);
+    mView.y = clampAxis(mView.y, mView.h, mWorld.y, mWorld.h);
+}
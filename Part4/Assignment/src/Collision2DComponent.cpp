@@ -1,38 +1,39 @@
-#pragma once
-
-#include "Component.hpp"
-#include "ComponentType.hpp"
-#include <SDL2/SDL.h>
-#include "Collision2DComponent.hpp"
-
-
-class Collision2DComponent : public Component {
-public:
-    Collision2DComponent();
-    ~Collision2DComponent();
-
-    ComponentType GetType() override { return ComponentType::Collision2DComponent; }
-
-    void Input(float deltaTime) override {}
-    void Update(float deltaTime) override;
-    void Render(SDL_Renderer* renderer) override;
-
-    void Move(float dx, float dy);
-    
-    float GetX() const;
-    float GetY() const;
-    float GetW() const;
-    float GetH() const;
-
-    void SetX(float x);
-    void SetY(float y);
-    void SetW(float w);
-    void SetH(float h);
-
-    SDL_FRect& GetRectangle();
-
-private:
-    SDL_FRect mRectangle;
-};
-
-template std::shared_ptr<Collision2DComponent> GameEntity::GetComponent<Collision2DComponent>(ComponentType);
\ No newline at end of file
+#include "../include/Collision2DComponent.hpp"
+#include "GameEntity.hpp"
+
+Collision2DComponent::Collision2DComponent() {
+    mRectangle = {0.0f, 0.0f, 40.0f, 40.0f};
+}
+
+Collision2DComponent::~Collision2DComponent() {}
+
+void Collision2DComponent::Update(float deltaTime) {
+    // Follow the owning entity's transform
+    GameEntity* entity = GetGameEntity();
+    if (!entity || !entity->HasComponent<TransformComponent>()) return;
+    mRectangle = entity->GetTransform().GetRectangle();
+}
+
+void Collision2DComponent::Render(SpriteBatch& batch) {
+    // Uncomment to see collision bounds while debugging
+    // batch.Fill(mRectangle, SDL_Color{255, 0, 0, 96}, RenderLayer::Overlay);
+}
+
+void Collision2DComponent::Move(float dx, float dy) {
+    mRectangle.x += dx;
+    mRectangle.y += dy;
+}
+
+float Collision2DComponent::GetX() const { return mRectangle.x; }
+float Collision2DComponent::GetY() const { return mRectangle.y; }
+float Collision2DComponent::GetW() const { return mRectangle.w; }
+float Collision2DComponent::GetH() const { return mRectangle.h; }
+
+void Collision2DComponent::SetX(float x) { mRectangle.x = x; }
+void Collision2DComponent::SetY(float y) { mRectangle.y = y; }
+void Collision2DComponent::SetW(float w) { mRectangle.w = w; }
+void Collision2DComponent::SetH(float h) { mRectangle.h = h; }
+
+SDL_FRect& Collision2DComponent::GetRectangle() {
+    return mRectangle;
+}
@@ -0,0 +1,71 @@
+#include "../include/ComponentStorage.hpp"
+#include "../include/GameEntity.hpp"
+
+ComponentStorage* ComponentStorage::mInstance = nullptr;
+
+ComponentStorage& ComponentStorage::Instance() {
+    if (mInstance == nullptr) {
+        mInstance = new ComponentStorage();
+    }
+    return *mInstance;
+}
+
+Archetype& ComponentStorage::FindOrCreate(ComponentSignature signature, const Archetype* from) {
+    for (auto& archetype : mArchetypes) {
+        if (archetype->mSignature == signature) {
+            return *archetype;
+        }
+    }
+
+    auto archetype = std::make_unique<Archetype>(signature);
+
+    // Columns for the types we already know about are cloned from the source
+    // archetype; the caller creates the column for the newly added type.
+    if (from) {
+        for (std::size_t i = 0; i < ComponentTypeCount; ++i) {
+            if (from->mColumns[i]) {
+                archetype->mColumns[i] = from->mColumns[i]->CloneEmpty();
+            }
+        }
+    }
+
+    mArchetypes.push_back(std::move(archetype));
+    return *mArchetypes.back();
+}
+
+void ComponentStorage::MoveEntity(GameEntity* entity, EntityLocation& location, Archetype& target) {
+    Archetype* source = location.archetype;
+    if (source) {
+        for (std::size_t i = 0; i < ComponentTypeCount; ++i) {
+            if (source->mColumns[i]) {
+                target.mColumns[i]->PushFrom(*source->mColumns[i], location.row);
+            }
+        }
+        RemoveRow(*source, location.row);
+    }
+
+    target.mEntities.push_back(entity);
+    location.archetype = &target;
+    location.row = target.mEntities.size() - 1;
+}
+
+void ComponentStorage::RemoveRow(Archetype& archetype, std::size_t row) {
+    for (auto& column : archetype.mColumns) {
+        if (column) column->SwapRemove(row);
+    }
+
+    // The last entity now lives in the vacated row.
+    GameEntity* moved = archetype.mEntities.back();
+    archetype.mEntities[row] = moved;
+    archetype.mEntities.pop_back();
+    if (row < archetype.mEntities.size()) {
+        moved->mLocation.row = row;
+    }
+}
+
+void ComponentStorage::Remove(EntityLocation& location) {
+    if (!location.archetype) return;
+
+    RemoveRow(*location.archetype, location.row);
+    location = EntityLocation{};
+}
@@ -1,97 +1,147 @@
 #include "Enemy.hpp"
+#include <algorithm>
 #include <cstdlib>
 #include <ctime>
-#include "iostream"
+#include "Log.hpp"
 
-Enemy::Enemy(SDL_Renderer* renderer) {
+Enemy::Enemy(ProjectilePool& projectiles, std::uint32_t seed)
+    : mProjectiles(&projectiles), mLauncher(projectiles.CreateLauncher(ProjectileTeam::Enemy)), mRandom(seed | 1u) {
     mRenderable = true;
 
     // Create transform component first with explicit dimensions
-    auto transform = std::make_shared<TransformComponent>();
-    transform->SetW(40.0f);  // Set explicit width
-    transform->SetH(40.0f);  // Set explicit height
-    AddComponent(ComponentType::TransformComponent, transform);
+    TransformComponent transform;
+    transform.SetW(40.0f);  // Set explicit width
+    transform.SetH(40.0f);  // Set explicit height
+    AddComponent(transform);
     
-    std::cout << "Enemy transform initialized with size: " 
-              << transform->GetW() << "x" << transform->GetH() << std::endl;
+    LOG_TRACE(Enemy, "Enemy transform initialized with size: %.0fx%.0f", transform.GetW(), transform.GetH());
 
     // Create texture component
-    auto texture = std::make_shared<TextureComponent>();
-    texture->CreateTextureComponent(renderer, "Assets/Alien.bmp");
-    AddComponent(ComponentType::TextureComponent, std::static_pointer_cast<Component>(texture));
+    TextureComponent texture;
+    texture.CreateTextureComponentAsync("Assets/Alien.bmp");
+    AddComponent(texture);
 
-    // Create projectile
-    auto projectile = std::make_shared<Projectile>();
-    
-    // Create transform for projectile with explicit dimensions
-    auto projTransform = std::make_shared<TransformComponent>();
-    projTransform->SetW(6.0f);  // Set width
-    projTransform->SetH(20.0f); // Set height
-    projectile->AddComponent(ComponentType::TransformComponent, projTransform);
-    
-    // Create texture for projectile
-    auto projTexture = std::make_shared<TextureComponent>();
-    projTexture->CreateTextureComponent(renderer, "Assets/Projectile.bmp");
-    projectile->AddComponent(ComponentType::TextureComponent, std::static_pointer_cast<Component>(projTexture));
-
-    mProjectile = projectile;
-    minLaunchTime = 1000 + rand() % 2000;
-    nextLaunchTime = SDL_GetTicks64() + minLaunchTime;
+    minLaunchTime = 1000 + NextRandom() % 2000;
+    nextLaunchTime = projectiles.GetTicks() + static_cast<Uint64>(minLaunchTime / sFireRate);
 }
 
 Enemy::~Enemy() {}
 
+std::uint32_t Enemy::NextRandom() {
+    mRandom ^= mRandom << 13;
+    mRandom ^= mRandom >> 17;
+    mRandom ^= mRandom << 5;
+    return mRandom;
+}
+
 void Enemy::Update(float deltaTime) {
     if (!mRenderable) return;
 
-    for (auto& [_, component] : mComponents) {
-        component->Update(deltaTime);
-    }
-
-    // Get both transform and texture components
-    auto transform = GetTransform();
-    auto texture = GetComponent<TextureComponent>(ComponentType::TextureComponent);
-    
-    if (!transform) return;
+    ForEachComponent([&](Component& component) {
+        component.Update(deltaTime);
+    });
 
-    // Move the enemy based on group direction
-    float dx = (sMoveRight ? 1.0f : -1.0f) * mSpeed * deltaTime;
-    transform->Move(dx, 0.0f);
+    if (!HasComponent<TransformComponent>()) return;
+    TransformComponent& transform = GetTransform();
 
-    // Update projectile
-    mProjectile->Update(deltaTime);
+    if (mFormation) {
+        // The formation already moved this tick
+        SnapToFormation();
+    } else {
+        // Move the enemy based on group direction
+        float dx = (sMoveRight ? 1.0f : -1.0f) * mSpeed * deltaTime;
+        transform.Move(dx, 0.0f);
+    }
 
     // Firing logic
-    Uint64 now = SDL_GetTicks64();
+    Uint64 now = mProjectiles->GetTicks();
     if (now >= nextLaunchTime && mRenderable) {
         // Calculate projectile position based on the transform
-        float projX = transform->GetX() + transform->GetW() / 2.0f - 3.0f; // Center the projectile
-        float projY = transform->GetY() + transform->GetH();
+        float projX = transform.GetX() + transform.GetW() / 2.0f - 3.0f; // Center the projectile
+        float projY = transform.GetY() + transform.GetH();
         
-        // Debug output
-        std::cout << "Enemy firing projectile at position: " << projX << ", " << projY << std::endl;
+        LOG_TRACE(Projectile, "Enemy firing projectile at position: %.1f, %.1f", projX, projY);
         
-        // Launch the projectile
-        mProjectile->Launch(projX, projY, false, 0);
-        nextLaunchTime = now + (rand() % 3000 + 1000);
+        // Launch the projectile once the update pass is over (may be on a worker thread)
+        mProjectiles->QueueLaunch(mLauncher, projX, projY, false, 0);
+        nextLaunchTime = now + static_cast<Uint64>((NextRandom() % mFireIntervalRange + mFireIntervalMin) / sFireRate);
     }
 }
 
+void Enemy::Revive() {
+    mRenderable = true;
+    nextLaunchTime = mProjectiles->GetTicks() + static_cast<Uint64>(minLaunchTime / sFireRate);
+}
 
-void Enemy::Render(SDL_Renderer* renderer) {
-    if (!mRenderable) return;
+void Enemy::SetFireInterval(float minMs, float maxMs) {
+    mFireIntervalMin = static_cast<std::uint32_t>(minMs);
+    mFireIntervalRange = std::max<std::uint32_t>(1, static_cast<std::uint32_t>(maxMs - minMs));
+}
 
-    for (auto& [_, component] : mComponents) {
-        component->Render(renderer);
-    }
+void Enemy::JoinFormation(Formation& formation, int column, int row) {
+    formation.Join(column, row);
+    mFormation = &formation;
+    mFormationOffset = formation.GetOffset(column, row);
+    mColumn = column;
+    mRow = row;
+}
+
+void Enemy::SnapToFormation() {
+    if (!mFormation) return;
+    const SDL_FPoint origin = mFormation->GetOrigin();
+    TransformComponent& transform = GetTransform();
+    transform.SetX(origin.x + mFormationOffset.x);
+    transform.SetY(origin.y + mFormationOffset.y);
+}
+
+void Enemy::LeaveFormation() {
+    if (!mFormation) return;
+    mFormation->Leave(mColumn, mRow);
+    mFormation = nullptr;
+}
+
+void Enemy::SaveState(EnemyState& state) {
+    state.rectangle = GetTransform().GetRectangle();
+    state.launcher = mLauncher;
+    state.nextLaunchTime = nextLaunchTime;
+    state.minLaunchTime = minLaunchTime;
+    state.fireIntervalMin = mFireIntervalMin;
+    state.fireIntervalRange = mFireIntervalRange;
+    state.random = mRandom;
+    state.formationOffset = mFormationOffset;
+    state.column = mColumn;
+    state.row = mRow;
+    state.inFormation = mFormation != nullptr;
+    state.renderable = mRenderable;
+}
+
+void Enemy::LoadState(const EnemyState& state, Formation& formation) {
+    TransformComponent& transform = GetTransform();
+    transform.GetRectangle() = state.rectangle;
+    transform.StorePrevious();
+    mLauncher = state.launcher;
+    nextLaunchTime = state.nextLaunchTime;
+    minLaunchTime = state.minLaunchTime;
+    mFireIntervalMin = state.fireIntervalMin;
+    mFireIntervalRange = state.fireIntervalRange;
+    mRandom = state.random;
+    mFormation = state.inFormation ? &formation : nullptr;
+    mFormationOffset = state.formationOffset;
+    mColumn = state.column;
+    mRow = state.row;
+    mRenderable = state.renderable;
+}
+
+void Enemy::Render(SpriteBatch& batch) {
+    if (!mRenderable) return;
 
-    mProjectile->Render(renderer);
+    ForEachComponent([&](Component& component) {
+        component.Render(batch);
+    });
 }
 
 float Enemy::sGroupSpeed = 100.0f;
 
 bool Enemy::sMoveRight = true;
 
-std::shared_ptr<Projectile> Enemy::GetProjectile() {
-    return mProjectile;
-}
\ No newline at end of file
+float Enemy::sFireRate = 1.0f;
@@ -0,0 +1,36 @@
+#include "../include/EntityRegistry.hpp"
+
+EntityRegistry* EntityRegistry::mInstance = nullptr;
+
+EntityRegistry& EntityRegistry::Instance() {
+    if (mInstance == nullptr) {
+        mInstance = new EntityRegistry();
+    }
+    return *mInstance;
+}
+
+EntityId EntityRegistry::Create(GameEntity* entity) {
+    std::uint32_t index;
+    if (!mFree.empty()) {
+        index = mFree.back();
+        mFree.pop_back();
+    } else {
+        index = static_cast<std::uint32_t>(mSlots.size());
+        mSlots.emplace_back();
+    }
+
+    Slot& slot = mSlots[index];
+    slot.entity = entity;
+    return {index, slot.generation};
+}
+
+void EntityRegistry::Destroy(EntityId id) {
+    if (id.index >= mSlots.size()) return;
+    Slot& slot = mSlots[id.index];
+    if (slot.generation != id.generation) return;
+
+    slot.entity = nullptr;
+    // Skip 0 on wrap-around so a default EntityId never matches
+    if (++slot.generation == 0) slot.generation = 1;
+    mFree.push_back(id.index);
+}
@@ -0,0 +1,112 @@
+#include "../include/Formation.hpp"
+#include "../include/Snapshot.hpp"
+#include <algorithm>
+
+void Formation::Reset(int columns, int rows, SDL_FPoint origin, SDL_FPoint spacing, SDL_FPoint memberSize) {
+    mOrigin = origin;
+    mPreviousOrigin = origin;
+    mSpacing = spacing;
+    mMemberSize = memberSize;
+    mColumnCount.assign(columns, 0);
+    mRowCount.assign(rows, 0);
+    mFirstColumn = columns;
+    mLastColumn = -1;
+    mFirstRow = rows;
+    mLastRow = -1;
+    mLive = 0;
+    ++mVersion;
+}
+
+void Formation::Join(int column, int row) {
+    ++mColumnCount[column];
+    ++mRowCount[row];
+    ++mLive;
+    ++mVersion;
+
+    mFirstColumn = std::min(mFirstColumn, column);
+    mLastColumn = std::max(mLastColumn, column);
+    mFirstRow = std::min(mFirstRow, row);
+    mLastRow = std::max(mLastRow, row);
+}
+
+void Formation::Leave(int column, int row) {
+    --mColumnCount[column];
+    --mRowCount[row];
+    --mLive;
+    ++mVersion;
+    if (mLive == 0) return;
+
+    // Only an emptied edge moves the bounds. Each edge only ever moves inwards,
+    // so over a whole wave these loops visit every row and column at most once.
+    while (mColumnCount[mFirstColumn] == 0) ++mFirstColumn;
+    while (mColumnCount[mLastColumn] == 0) --mLastColumn;
+    while (mRowCount[mFirstRow] == 0) ++mFirstRow;
+    while (mRowCount[mLastRow] == 0) --mLastRow;
+}
+
+SDL_FPoint Formation::GetExtent() const {
+    if (mColumnCount.empty() || mRowCount.empty()) return {0.0f, 0.0f};
+
+    const SDL_FPoint last = GetOffset(static_cast<int>(mColumnCount.size()) - 1, static_cast<int>(mRowCount.size()) - 1);
+    return {last.x + mMemberSize.x, last.y + mMemberSize.y};
+}
+
+SDL_FRect Formation::GetBounds() const {
+    if (mLive == 0) return {mOrigin.x, mOrigin.y, 0.0f, 0.0f};
+
+    const SDL_FPoint topLeft = GetOffset(mFirstColumn, mFirstRow);
+    const SDL_FPoint bottomRight = GetOffset(mLastColumn, mLastRow);
+    return {mOrigin.x + topLeft.x, mOrigin.y + topLeft.y,
+            bottomRight.x - topLeft.x + mMemberSize.x, bottomRight.y - topLeft.y + mMemberSize.y};
+}
+
+void Formation::SaveState(SnapshotWriter& writer) const {
+    writer.Write(mOrigin);
+    writer.Write(mSpacing);
+    writer.Write(mMemberSize);
+    writer.Write(mFirstColumn);
+    writer.Write(mLastColumn);
+    writer.Write(mFirstRow);
+    writer.Write(mLastRow);
+    writer.Write(mLive);
+    writer.Write(static_cast<std::uint32_t>(mColumnCount.size()));
+    writer.Write(static_cast<std::uint32_t>(mRowCount.size()));
+    writer.WriteArray(mColumnCount.data(), mColumnCount.size());
+    writer.WriteArray(mRowCount.data(), mRowCount.size());
+}
+
+bool Formation::LoadState(SnapshotReader& reader) {
+    std::uint32_t columns = 0;
+    std::uint32_t rows = 0;
+    reader.Read(mOrigin);
+    reader.Read(mSpacing);
+    reader.Read(mMemberSize);
+    reader.Read(mFirstColumn);
+    reader.Read(mLastColumn);
+    reader.Read(mFirstRow);
+    reader.Read(mLastRow);
+    reader.Read(mLive);
+    reader.Read(columns);
+    reader.Read(rows);
+    // Level waves are at most 65535 slots a side
+    if (!reader.IsValid() || columns > 0xFFFF || rows > 0xFFFF) return false;
+
+    mColumnCount.resize(columns);
+    mRowCount.resize(rows);
+    reader.ReadArray(mColumnCount.data(), columns);
+    reader.ReadArray(mRowCount.data(), rows);
+    mPreviousOrigin = mOrigin;
+    ++mVersion;
+    return reader.IsValid();
+}
+
+bool Formation::SkipState(SnapshotReader& reader) {
+    std::uint32_t columns = 0;
+    std::uint32_t rows = 0;
+    reader.Skip(sizeof(mOrigin) + sizeof(mSpacing) + sizeof(mMemberSize) + sizeof(mFirstColumn) +
+                sizeof(mLastColumn) + sizeof(mFirstRow) + sizeof(mLastRow) + sizeof(mLive));
+    reader.Read(columns);
+    reader.Read(rows);
+    if (!reader.IsValid() || columns > 0xFFFF || rows > 0xFFFF) return false;
+    return reader.Skip((static_cast<std::size_t>(columns) + rows) * sizeof(std::uint32_t));
+}
@@ -2,11 +2,16 @@
 #include "TextureComponent.hpp"
 #include "InputComponent.hpp"
 #include "TransformComponent.hpp"
+#include "Log.hpp"
+#include <typeinfo>
 
 
-GameEntity::GameEntity() : mRenderable(true) {}
+GameEntity::GameEntity() : mId(EntityRegistry::Instance().Create(this)), mRenderable(true) {}
 
-GameEntity::~GameEntity() {}
+GameEntity::~GameEntity() {
+    ComponentStorage::Instance().Remove(mLocation);
+    EntityRegistry::Instance().Destroy(mId);
+}
 
 void GameEntity::Input(float deltaTime) {
     // This may remain empty if not overridden in children
@@ -16,7 +21,7 @@ void GameEntity::Update(float deltaTime) {
     // abstract behavior - should be overridden
 }
 
-void GameEntity::Render(SDL_Renderer* renderer) {
+void GameEntity::Render(SpriteBatch& batch) {
     // abstract behavior - should be overridden
 }
 
@@ -34,49 +39,31 @@ bool GameEntity::GetRenderable() {
 }
 
 
-void GameEntity::AddComponent(ComponentType type, std::shared_ptr<Component> component) {
-    // Don't try to set the game entity pointer here if we're still in the constructor
-    // Just add the component to the map
-    mComponents[type] = component;
-    
-    // If we already have a shared_ptr to this object, set the game entity on the component
-    try {
-        if (component) {
-            component->SetGameEntity(shared_from_this());
-            std::cout << "[DEBUG] Successfully set GameEntity on component" << std::endl;
-        }
-    } catch (const std::bad_weak_ptr& e) {
-        // This will happen during construction, which is expected
-        // Just store the component without setting its owner yet
-        std::cout << "[DEBUG] Could not set GameEntity yet (expected during construction)" << std::endl;
-    }
-}
-
 template <typename T>
-std::shared_ptr<T> GameEntity::GetComponent(ComponentType type) {
-    auto found = mComponents.find(type);
-    if (found != mComponents.end()) {
-        return std::dynamic_pointer_cast<T>(found->second);
-    }
-    return nullptr;
+T& GameEntity::AddComponent(const T& component) {
+    T* stored = ComponentStorage::Instance().Add(this, mLocation, component);
+    mSignature |= SignatureOf(ComponentTypeOf<T>);
+
+    // Our id is valid from the constructor on, so this works during construction too
+    stored->SetGameEntity(mId);
+
+    return *stored;
 }
 
-bool GameEntity::TestCollision(std::shared_ptr<GameEntity> other) {
-    auto aCollision = GetComponent<Collision2DComponent>(ComponentType::Collision2DComponent);
-    auto bCollision = other->GetComponent<Collision2DComponent>(ComponentType::Collision2DComponent);
+bool GameEntity::TestCollision(GameEntity& other) {
+    auto aCollision = TryGetComponent<Collision2DComponent>();
+    auto bCollision = other.TryGetComponent<Collision2DComponent>();
     
     if (!aCollision || !bCollision) {
-        std::cerr << "TestCollision: Missing Collision2DComponent!" << std::endl;
+        LOG_WARN(Collision, "TestCollision: Missing Collision2DComponent!");
         return false;
     }
 
     SDL_FRect a = aCollision->GetRectangle();
     SDL_FRect b = bCollision->GetRectangle();
     
-    // Debug collision test
-    std::cout << "Testing collision between entities at: " 
-              << "A(" << a.x << "," << a.y << "," << a.w << "," << a.h << ") and "
-              << "B(" << b.x << "," << b.y << "," << b.w << "," << b.h << ")" << std::endl;
+    LOG_TRACE(Collision, "Testing collision between entities at: A(%.1f,%.1f,%.1f,%.1f) and B(%.1f,%.1f,%.1f,%.1f)",
+              a.x, a.y, a.w, a.h, b.x, b.y, b.w, b.h);
     
     // Check for intersection
     bool collision = !(b.x + b.w <= a.x ||
@@ -85,69 +72,45 @@ bool GameEntity::TestCollision(std::shared_ptr<GameEntity> other) {
                       a.y + a.h <= b.y);
                       
     if (collision) {
-        std::cout << "COLLISION DETECTED!" << std::endl;
+        LOG_TRACE(Collision, "Collision detected");
     }
     
     return collision;
 }
 void GameEntity::AddDefaultTransform() {
-    std::cout << "Calling AddDefaultTransform() for " << typeid(*this).name() << " at " << this << std::endl;
+    LOG_TRACE(Entity, "Calling AddDefaultTransform() for %s at %p", typeid(*this).name(), static_cast<void*>(this));
     
     // Create the transform component
-    auto transform = std::make_shared<TransformComponent>();
+    TransformComponent transform;
     
-    // Just add it to the components map - don't try to set its owner yet
-    mComponents[ComponentType::TransformComponent] = transform;
-    
-    // The owner relationship will be set later when InitializeComponents() is called
-    std::cout << "[DEBUG] Added TransformComponent to " << typeid(*this).name() << " at " << this << "\n";
+    AddComponent(transform);
+
+    LOG_TRACE(Entity, "Added TransformComponent to %s at %p", typeid(*this).name(), static_cast<void*>(this));
 }
 
 
 
-std::shared_ptr<TransformComponent> GameEntity::GetTransform() {
-    return GetComponent<TransformComponent>(ComponentType::TransformComponent);
-}
+void GameEntity::InitializeComponents() {
+    // Components are linked to us as they're added; this only fixes up defaults
+    // once the entity is fully built.
+    LOG_TRACE(Entity, "Initializing components for %s at %p", typeid(*this).name(), static_cast<void*>(this));
 
-std::shared_ptr<GameEntity> GameEntity::GetThisPtr() {
-    std::cout << "[DEBUG] Calling GetThisPtr() on " << typeid(*this).name() << " at " << this << std::endl;
-    return shared_from_this();  // Safely returns shared_ptr to this
-}
+    // Specifically ensure texture component has reference to transform
+    auto texture = TryGetComponent<TextureComponent>();
+    auto transform = TryGetComponent<TransformComponent>();
 
-void GameEntity::InitializeComponents() {
-    // Call this after the GameEntity is fully constructed and managed by a shared_ptr
-    try {
-        std::shared_ptr<GameEntity> thisPtr = shared_from_this();
-        
-        std::cout << "Initializing components for " << typeid(*this).name() << " at " << this << std::endl;
-        
-        for (auto& [type, component] : mComponents) {
-            if (component) {
-                std::cout << "  Setting GameEntity for component type " << static_cast<int>(type) << std::endl;
-                component->SetGameEntity(thisPtr);
-            }
-        }
-        
-        // Specifically ensure texture component has reference to transform
-        auto texture = GetComponent<TextureComponent>(ComponentType::TextureComponent);
-        auto transform = GetTransform();
-        
-        if (texture && transform) {
-            // Ensure texture dimensions match transform if not already set
-            if (transform->GetW() <= 0) transform->SetW(40.0f);
-            if (transform->GetH() <= 0) transform->SetH(40.0f);
-            
-            std::cout << "  Transform dimensions: " << transform->GetW() << "x" << transform->GetH() << std::endl;
-        }
-        
-        std::cout << "Successfully initialized all components for " << typeid(*this).name() << std::endl;
-    } catch (const std::bad_weak_ptr& e) {
-        std::cerr << "[ERROR] InitializeComponents called before object is managed by shared_ptr" << std::endl;
+    if (texture && transform) {
+        // Ensure texture dimensions match transform if not already set
+        if (transform->GetW() <= 0) transform->SetW(40.0f);
+        if (transform->GetH() <= 0) transform->SetH(40.0f);
+
+        LOG_TRACE(Entity, "  Transform dimensions: %.0fx%.0f", transform->GetW(), transform->GetH());
     }
 }
 
 
 
-template std::shared_ptr<TextureComponent> GameEntity::GetComponent<TextureComponent>(ComponentType);
-template std::shared_ptr<InputComponent> GameEntity::GetComponent<InputComponent>(ComponentType);
-template std::shared_ptr<TransformComponent> GameEntity::GetComponent<TransformComponent>(ComponentType);
+template TextureComponent& GameEntity::AddComponent<TextureComponent>(const TextureComponent&);
+template InputComponent& GameEntity::AddComponent<InputComponent>(const InputComponent&);
+template TransformComponent& GameEntity::AddComponent<TransformComponent>(const TransformComponent&);
+template Collision2DComponent& GameEntity::AddComponent<Collision2DComponent>(const Collision2DComponent&);
@@ -1,37 +1,36 @@
 #include "InputComponent.hpp"
 #include "GameEntity.hpp"
+#include "Player.hpp"
 #include "TextureComponent.hpp"
-#include "iostream"
+#include "Log.hpp"
+
+float InputComponent::MoveX(std::uint8_t buttons, float deltaTime) {
+    float dx = 0.0f;
+    if (buttons & InputLeft) dx -= Speed;
+    if (buttons & InputRight) dx += Speed;
+    return dx * deltaTime;
+}
 
 void InputComponent::Input(float deltaTime) {
-    const Uint8* keyState = SDL_GetKeyboardState(nullptr);
-    
     // Handle movement
-    auto transform = mGameEntity->GetTransform();
-    if (!transform) return;
+    GameEntity* entity = GetGameEntity();
+    if (!entity || !entity->HasComponent<TransformComponent>()) return;
+    TransformComponent& transform = entity->GetTransform();
 
-    float dx = 0.0f;
-    if (keyState[SDL_SCANCODE_LEFT]) dx -= mSpeed;
-    if (keyState[SDL_SCANCODE_RIGHT]) dx += mSpeed;
+    // The buttons were sampled (or replayed) for this tick by the application
+    Player* player = static_cast<Player*>(entity);
+    const std::uint8_t buttons = player->GetInputButtons();
 
     // Move the player
-    std::cout << "Transform X before: " << transform->GetX() << std::endl;
-    transform->Move(dx * deltaTime, 0.0f);
-    std::cout << "Transform X after: " << transform->GetX() << std::endl;
+    transform.Move(MoveX(buttons, deltaTime), 0.0f);
+    LOG_TRACE(Input, "Player moved to x=%.1f", transform.GetX());
     
     // Handle firing
-    if (keyState[SDL_SCANCODE_SPACE]) {
-        // Cast the game entity to Player to access the projectile
-        std::shared_ptr<Player> player = std::static_pointer_cast<Player>(mGameEntity);
-        if (player) {
-            auto projectile = player->GetProjectile();
-            if (projectile) {
-                float projX = transform->GetX() + transform->GetW() / 2.0f - 3.0f; // Center projectile
-                float projY = transform->GetY() - 5.0f; // Slightly above player
-                
-                std::cout << "Firing projectile from InputComponent at: " << projX << ", " << projY << std::endl;
-                projectile->Launch(projX, projY, true, 500); // Fire upward with 500ms cooldown
-            }
-        }
+    if (buttons & InputFire) {
+        float projX = transform.GetX() + transform.GetW() / 2.0f - 3.0f; // Center projectile
+        float projY = transform.GetY() - 5.0f; // Slightly above player
+
+        LOG_TRACE(Input, "Firing projectile from InputComponent at: %.1f, %.1f", projX, projY);
+        player->Launch(projX, projY, 500); // Fire upward with 500ms cooldown
     }
 }
\ No newline at end of file
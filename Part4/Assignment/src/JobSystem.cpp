@@ -0,0 +1,161 @@
+#include "../include/JobSystem.hpp"
+#include <algorithm>
+
+JobSystem* JobSystem::mInstance = nullptr;
+
+namespace {
+// Which queue the current thread owns; 0 for every thread that isn't a worker
+thread_local std::size_t sQueueIndex = 0;
+}
+
+JobSystem& JobSystem::Instance() {
+    if (mInstance == nullptr) {
+        mInstance = new JobSystem();
+    }
+    return *mInstance;
+}
+
+JobSystem::JobSystem() {
+    mQueues.push_back(std::make_unique<WorkQueue>());
+}
+
+void JobSystem::WorkQueue::PushBack(const Job& job) {
+    if (count == ring.size()) {
+        // Unroll into a buffer twice the size, oldest job first
+        std::vector<Job> grown(ring.size() * 2);
+        for (std::size_t i = 0; i < count; ++i) {
+            grown[i] = ring[(head + i) % ring.size()];
+        }
+        ring.swap(grown);
+        head = 0;
+    }
+    ring[(head + count) % ring.size()] = job;
+    ++count;
+}
+
+JobSystem::Job JobSystem::WorkQueue::PopBack() {
+    --count;
+    return ring[(head + count) % ring.size()];
+}
+
+JobSystem::Job JobSystem::WorkQueue::PopFront() {
+    Job job = ring[head];
+    head = (head + 1) % ring.size();
+    --count;
+    return job;
+}
+
+void JobSystem::Start(std::size_t workerCount) {
+    Stop();
+
+    mQueues.resize(1);
+    for (std::size_t i = 0; i < workerCount; ++i) {
+        mQueues.push_back(std::make_unique<WorkQueue>());
+    }
+
+    mRunning.store(true);
+    for (std::size_t i = 0; i < workerCount; ++i) {
+        mThreads.emplace_back(&JobSystem::WorkerThread, this, i + 1);
+    }
+}
+
+void JobSystem::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+        mRunning.store(false);
+    }
+    mWake.notify_all();
+
+    for (std::thread& thread : mThreads) {
+        thread.join();
+    }
+    mThreads.clear();
+}
+
+void JobSystem::Dispatch(JobFunction function, void* context, std::size_t count, std::size_t grain, JobCounter& counter) {
+    const std::size_t chunks = (count + grain - 1) / grain;
+    counter.pending.fetch_add(chunks, std::memory_order_relaxed);
+
+    // Count the jobs before they become visible, so a thief's decrement can't
+    // get ahead of this increment. Taking the lock orders it with a worker
+    // that is about to go to sleep.
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+        mQueued.fetch_add(chunks, std::memory_order_release);
+    }
+
+    WorkQueue& queue = *mQueues[sQueueIndex];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        for (std::size_t begin = 0; begin < count; begin += grain) {
+            queue.PushBack({function, context, begin, std::min(begin + grain, count), &counter});
+        }
+    }
+
+    if (chunks == 1) {
+        mWake.notify_one();
+    } else {
+        mWake.notify_all();
+    }
+}
+
+bool JobSystem::PopOrSteal(std::size_t self, Job& job) {
+    // Own queue first, newest job (still warm in cache)
+    {
+        WorkQueue& queue = *mQueues[self];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.count > 0) {
+            job = queue.PopBack();
+            mQueued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    // Then steal the oldest job from someone else, starting with our neighbour
+    const std::size_t queueCount = mQueues.size();
+    for (std::size_t offset = 1; offset < queueCount; ++offset) {
+        WorkQueue& queue = *mQueues[(self + offset) % queueCount];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.count > 0) {
+            job = queue.PopFront();
+            mQueued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobSystem::Execute(const Job& job) {
+    job.function(job.context, job.begin, job.end);
+    job.counter->pending.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void JobSystem::Wait(JobCounter& counter) {
+    Job job;
+    while (counter.pending.load(std::memory_order_acquire) > 0) {
+        if (PopOrSteal(sQueueIndex, job)) {
+            Execute(job);
+        } else {
+            // The rest is already running on other threads
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::WorkerThread(std::size_t index) {
+    sQueueIndex = index;
+
+    Job job;
+    while (true) {
+        if (PopOrSteal(index, job)) {
+            Execute(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mSleepMutex);
+        mWake.wait(lock, [&] {
+            return !mRunning.load() || mQueued.load(std::memory_order_acquire) > 0;
+        });
+        if (!mRunning.load()) return;
+    }
+}
@@ -0,0 +1,164 @@
+#include "../include/Level.hpp"
+#include "../include/Log.hpp"
+#include <bit>
+#include <cstring>
+
+#ifdef _WIN32
+#include <cstdio>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static_assert(std::endian::native == std::endian::little, "level files are read in place as little-endian");
+
+namespace {
+
+// Whether `count` records of `size` bytes starting at `offset` fit in the file
+bool InRange(std::size_t fileSize, std::uint32_t offset, std::uint32_t count, std::size_t size) {
+    return offset % 4 == 0 && offset <= fileSize && count <= (fileSize - offset) / size;
+}
+
+} // namespace
+
+LevelFile::~LevelFile() {
+    Close();
+}
+
+bool LevelFile::Open(const std::string& filePath) {
+    Close();
+
+#ifdef _WIN32
+    // No mmap here: read the file into one buffer instead
+    FILE* file = std::fopen(filePath.c_str(), "rb");
+    if (!file) {
+        LOG_ERROR(Resource, "Failed to open level %s", filePath.c_str());
+        return false;
+    }
+    std::fseek(file, 0, SEEK_END);
+    const long size = std::ftell(file);
+    std::fseek(file, 0, SEEK_SET);
+    std::byte* buffer = size > 0 ? new std::byte[size] : nullptr;
+    const bool ok = buffer && std::fread(buffer, 1, size, file) == static_cast<std::size_t>(size);
+    std::fclose(file);
+    if (!ok) {
+        delete[] buffer;
+        LOG_ERROR(Resource, "Failed to read level %s", filePath.c_str());
+        return false;
+    }
+    mData = buffer;
+    mSize = static_cast<std::size_t>(size);
+#else
+    const int fd = open(filePath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        LOG_ERROR(Resource, "Failed to open level %s", filePath.c_str());
+        return false;
+    }
+
+    struct stat info;
+    void* mapping = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        mapping = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd); // the mapping keeps the file alive
+
+    if (mapping == MAP_FAILED) {
+        LOG_ERROR(Resource, "Failed to map level %s", filePath.c_str());
+        return false;
+    }
+    mData = static_cast<const std::byte*>(mapping);
+    mSize = static_cast<std::size_t>(info.st_size);
+#endif
+
+    if (!Validate(filePath)) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+bool LevelFile::Validate(const std::string& filePath) {
+    if (mSize < LevelHeaderSizeV1) {
+        LOG_ERROR(Resource, "Level %s is too short for a header", filePath.c_str());
+        return false;
+    }
+
+    const LevelHeader& header = *reinterpret_cast<const LevelHeader*>(mData);
+    if (std::memcmp(header.magic, LevelMagic, sizeof(LevelMagic)) != 0) {
+        LOG_ERROR(Resource, "%s is not a level file", filePath.c_str());
+        return false;
+    }
+    // Version 1 is version 2 without the world size, so both load
+    const bool known = (header.version == 1 && header.headerSize == LevelHeaderSizeV1) ||
+                       (header.version == LevelVersion && header.headerSize == sizeof(LevelHeader));
+    if (!known || mSize < header.headerSize) {
+        LOG_ERROR(Resource, "Level %s is version %u, expected %u", filePath.c_str(), header.version, LevelVersion);
+        return false;
+    }
+    mWorldWidth = LevelDefaultWorldWidth;
+    mWorldHeight = LevelDefaultWorldHeight;
+    if (header.version >= 2) {
+        mWorldWidth = header.worldWidth;
+        mWorldHeight = header.worldHeight;
+        if (!IsValidWorldSize(mWorldWidth) || !IsValidWorldSize(mWorldHeight)) {
+            LOG_ERROR(Resource, "Level %s has a world of %gx%g; each side must be above 0 and at most %g",
+                      filePath.c_str(), mWorldWidth, mWorldHeight, LevelMaxWorldSize);
+            return false;
+        }
+    }
+    if (!InRange(mSize, header.prefabOffset, header.prefabCount, sizeof(LevelPrefab)) ||
+        !InRange(mSize, header.waveOffset, header.waveCount, sizeof(LevelWave)) ||
+        !InRange(mSize, header.slotOffset, header.slotCount, sizeof(LevelSlot))) {
+        LOG_ERROR(Resource, "Level %s has a table outside the file", filePath.c_str());
+        return false;
+    }
+
+    mPrefabs = {reinterpret_cast<const LevelPrefab*>(mData + header.prefabOffset), header.prefabCount};
+    mWaves = {reinterpret_cast<const LevelWave*>(mData + header.waveOffset), header.waveCount};
+    mSlots = {reinterpret_cast<const LevelSlot*>(mData + header.slotOffset), header.slotCount};
+
+    for (const LevelPrefab& prefab : mPrefabs) {
+        if (std::memchr(prefab.texture, '\0', sizeof(prefab.texture)) == nullptr ||
+            !(prefab.width > 0.0f && prefab.height > 0.0f) ||
+            !(prefab.minFireIntervalMs >= 0.0f && prefab.maxFireIntervalMs > prefab.minFireIntervalMs)) {
+            LOG_ERROR(Resource, "Level %s has a bad prefab", filePath.c_str());
+            return false;
+        }
+    }
+
+    for (std::size_t i = 0; i < mWaves.size(); ++i) {
+        const LevelWave& wave = mWaves[i];
+        const bool ok = wave.prefab < mPrefabs.size() && wave.columns > 0 && wave.rows > 0 &&
+                        static_cast<std::size_t>(wave.columns) * wave.rows <= LevelMaxWaveSlots &&
+                        wave.fireRate > 0.0f && wave.firstSlot <= mSlots.size() &&
+                        wave.slotCount <= mSlots.size() - wave.firstSlot;
+        if (!ok) {
+            LOG_ERROR(Resource, "Level %s: wave %zu is invalid", filePath.c_str(), i);
+            return false;
+        }
+        for (const LevelSlot& slot : GetSlots(wave)) {
+            if (slot.column >= wave.columns || slot.row >= wave.rows) {
+                LOG_ERROR(Resource, "Level %s: wave %zu has a slot outside its grid", filePath.c_str(), i);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void LevelFile::Close() {
+    if (mData) {
+#ifdef _WIN32
+        delete[] mData;
+#else
+        munmap(const_cast<std::byte*>(mData), mSize);
+#endif
+    }
+    mData = nullptr;
+    mSize = 0;
+    mPrefabs = {};
+    mWaves = {};
+    mSlots = {};
+}
@@ -0,0 +1,175 @@
+#include "../include/Log.hpp"
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+
+Logger* Logger::mInstance = nullptr;
+
+namespace {
+
+std::int64_t NowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+const char* LevelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::Trace: return "TRACE";
+        case LogLevel::Debug: return "DEBUG";
+        case LogLevel::Info:  return "INFO ";
+        case LogLevel::Warn:  return "WARN ";
+        case LogLevel::Error: return "ERROR";
+    }
+    return "?    ";
+}
+
+const char* CategoryName(LogCategory category) {
+    switch (category) {
+        case LogCategory::Core:       return "core";
+        case LogCategory::Entity:     return "entity";
+        case LogCategory::Input:      return "input";
+        case LogCategory::Enemy:      return "enemy";
+        case LogCategory::Collision:  return "collision";
+        case LogCategory::Projectile: return "projectile";
+        case LogCategory::Resource:   return "resource";
+        case LogCategory::Net:        return "net";
+        case LogCategory::Count:      break;
+    }
+    return "?";
+}
+
+constexpr std::int64_t OneSecondNs = 1000000000;
+
+// Per-frame chatter is capped so a busy wave can't flood the writer; warnings and errors skip the cap
+constexpr std::uint32_t DefaultRateLimit = 200;
+
+} // namespace
+
+Logger& Logger::Instance() {
+    if (mInstance == nullptr) {
+        mInstance = new Logger();
+    }
+    return *mInstance;
+}
+
+Logger::Logger() : mSlots(new Slot[Capacity]), mStartTime(NowNs()) {
+    for (std::size_t i = 0; i < Capacity; ++i) {
+        mSlots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    for (auto& rate : mRates) {
+        rate.limit.store(DefaultRateLimit, std::memory_order_relaxed);
+    }
+    mWriter = std::thread(&Logger::WriterThread, this);
+}
+
+void Logger::SetRateLimit(LogCategory category, std::uint32_t messagesPerSecond) {
+    mRates[static_cast<std::size_t>(category)].limit.store(messagesPerSecond, std::memory_order_relaxed);
+}
+
+bool Logger::Admit(LogCategory category, std::int64_t now) {
+    RateWindow& rate = mRates[static_cast<std::size_t>(category)];
+    const std::uint32_t limit = rate.limit.load(std::memory_order_relaxed);
+    if (limit == 0) return true;
+
+    // Fixed one-second windows; whoever notices the window expired resets it
+    std::int64_t start = rate.start.load(std::memory_order_relaxed);
+    if (now - start >= OneSecondNs &&
+        rate.start.compare_exchange_strong(start, now, std::memory_order_relaxed)) {
+        rate.count.store(0, std::memory_order_relaxed);
+    }
+    return rate.count.fetch_add(1, std::memory_order_relaxed) < limit;
+}
+
+void Logger::Write(LogLevel level, LogCategory category, const char* format, ...) {
+    const std::int64_t now = NowNs();
+    if (level < LogLevel::Warn && !Admit(category, now)) {
+        mDropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // Claim a slot (bounded MPMC queue, after Dmitry Vyukov)
+    std::size_t pos = mEnqueuePos.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+        slot = &mSlots[pos & (Capacity - 1)];
+        const std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        const std::intptr_t diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+        if (diff == 0) {
+            if (mEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            mDropped.fetch_add(1, std::memory_order_relaxed); // Ring is full
+            return;
+        } else {
+            pos = mEnqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->timestamp = now - mStartTime;
+    slot->level = level;
+    slot->category = category;
+
+    va_list args;
+    va_start(args, format);
+    std::vsnprintf(slot->text, MessageSize, format, args);
+    va_end(args);
+
+    slot->sequence.store(pos + 1, std::memory_order_release);
+}
+
+std::size_t Logger::Drain() {
+    std::size_t written = 0;
+    std::size_t pos = mDequeuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = mSlots[pos & (Capacity - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != pos + 1) break;
+
+        FILE* stream = slot.level >= LogLevel::Warn ? stderr : stdout;
+        std::fprintf(stream, "[%10.4f] %s %s: %s\n",
+                     static_cast<double>(slot.timestamp) / OneSecondNs,
+                     LevelName(slot.level), CategoryName(slot.category), slot.text);
+
+        slot.sequence.store(pos + Capacity, std::memory_order_release);
+        ++pos;
+        ++written;
+    }
+    mDequeuePos.store(pos, std::memory_order_release);
+
+    if (written > 0) {
+        std::fflush(stdout);
+        std::fflush(stderr);
+    }
+    return written;
+}
+
+void Logger::WriterThread() {
+    while (mRunning.load(std::memory_order_acquire)) {
+        if (Drain() == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+    Drain();
+}
+
+void Logger::Flush() {
+    const std::size_t target = mEnqueuePos.load(std::memory_order_acquire);
+    if (!mWriter.joinable()) {
+        Drain();
+        return;
+    }
+    while (mDequeuePos.load(std::memory_order_acquire) < target) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+void Logger::Stop() {
+    if (!mWriter.joinable()) return;
+
+    mRunning.store(false, std::memory_order_release);
+    mWriter.join();
+
+    const std::uint64_t dropped = GetDroppedCount();
+    if (dropped > 0) {
+        std::fprintf(stderr, "[log] %llu messages dropped (rate limit or full buffer)\n",
+                     static_cast<unsigned long long>(dropped));
+    }
+}
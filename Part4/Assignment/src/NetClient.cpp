@@ -0,0 +1,134 @@
+#include "../include/NetClient.hpp"
+#include "../include/Log.hpp"
+#include <algorithm>
+#include <cstring>
+
+bool NetClient::Connect(const NetAddress& server, double nowMs) {
+    if (!mSocket.Open(0)) return false;
+    mServer = server;
+    mStatus = Status::Connecting;
+    mHasState = false;
+    mHasInputAck = false;
+    mInputTicks = 0;
+    mValid.fill(false);
+    SendConnect(nowMs);
+    return true;
+}
+
+void NetClient::Disconnect(double nowMs) {
+    if (mStatus == Status::Connected) {
+        const std::uint8_t packet = static_cast<std::uint8_t>(NetPacket::Disconnect);
+        mSocket.Send(mServer, &packet, 1, nowMs);
+        // Don't leave the goodbye in the latency queue
+        mSocket.Flush(nowMs + 1.0e9);
+    }
+    mSocket.Close();
+    mStatus = Status::Off;
+}
+
+void NetClient::SendConnect(double nowMs) {
+    std::uint8_t buffer[8];
+    BitWriter writer(buffer, sizeof(buffer));
+    writer.WriteBits(static_cast<std::uint32_t>(NetPacket::Connect), 8);
+    writer.WriteBits(NetProtocolId, 32);
+    mSocket.Send(mServer, buffer, writer.GetBytesWritten(), nowMs);
+    mLastConnectMs = nowMs;
+}
+
+bool NetClient::Receive(double nowMs) {
+    if (mStatus == Status::Connecting && nowMs - mLastConnectMs >= ConnectRetryMs) {
+        SendConnect(nowMs);
+    }
+
+    const std::uint16_t latest = mLatest;
+    const bool hadState = mHasState;
+
+    std::uint8_t buffer[NetMaxPacket];
+    NetAddress from;
+    while (std::size_t size = mSocket.Receive(from, buffer, sizeof(buffer))) {
+        if (!(from == mServer)) continue;
+        mBytesReceived += size;
+
+        BitReader reader(buffer, size);
+        const auto type = static_cast<NetPacket>(reader.ReadBits(8));
+        if (type == NetPacket::Accept && mStatus == Status::Connecting) {
+            mInfo.slot = static_cast<std::uint8_t>(reader.ReadBits(8));
+            mInfo.sendInterval = static_cast<std::uint8_t>(reader.ReadBits(8));
+            const std::uint32_t rate = reader.ReadBits(32);
+            std::memcpy(&mInfo.simulationRate, &rate, sizeof(rate));
+            for (char& c : mInfo.level) {
+                c = static_cast<char>(reader.ReadBits(8));
+            }
+            mInfo.level[sizeof(mInfo.level) - 1] = '\0';
+            if (reader.HasOverflowed() || mInfo.slot == 0 || mInfo.slot >= NetMaxPlayers || mInfo.sendInterval == 0) {
+                continue;
+            }
+            mStatus = Status::Connected;
+            LOG_INFO(Net, "Joined as player %u", static_cast<unsigned>(mInfo.slot));
+        } else if (type == NetPacket::Reject && mStatus == Status::Connecting) {
+            LOG_ERROR(Net, "Server is full");
+            mStatus = Status::Rejected;
+        } else if (type == NetPacket::Snapshot && mStatus == Status::Connected) {
+            HandleSnapshot(reader);
+        }
+    }
+
+    return mHasState && (!hadState || mLatest != latest);
+}
+
+void NetClient::HandleSnapshot(BitReader& reader) {
+    const auto sequence = static_cast<std::uint16_t>(reader.ReadBits(16));
+    const bool hasBaseline = reader.ReadBool();
+    const auto baselineSequence = static_cast<std::uint16_t>(hasBaseline ? reader.ReadBits(16) : 0);
+    const bool hasInputAck = reader.ReadBool();
+    const std::uint32_t inputAck = hasInputAck ? reader.ReadBits(32) : 0;
+    if (reader.HasOverflowed()) return;
+
+    // Late or duplicated: we've moved past it
+    if (mHasState && !SequenceNewer(sequence, mLatest)) return;
+
+    const NetWorldState* baseline = nullptr;
+    if (hasBaseline) {
+        const std::size_t index = baselineSequence % HistorySize;
+        if (!mValid[index] || mStates[index].sequence != baselineSequence) return;
+        baseline = &mStates[index];
+    }
+
+    const std::size_t index = sequence % HistorySize;
+    if (baseline == &mStates[index]) return;
+    mValid[index] = false;
+    NetWorldState& state = mStates[index];
+    if (!DecodeWorldState(reader, baseline, state)) {
+        LOG_WARN(Net, "Dropped a snapshot that didn't decode");
+        return;
+    }
+    state.sequence = sequence;
+    mValid[index] = true;
+
+    mLatest = sequence;
+    mHasState = true;
+    mHasInputAck = hasInputAck;
+    mInputAck = inputAck;
+    ++mSnapshotsReceived;
+}
+
+void NetClient::SendInput(std::uint32_t tick, std::uint8_t buttons, double nowMs) {
+    if (mStatus != Status::Connected) return;
+
+    mRecentButtons[tick % NetInputRedundancy] = buttons;
+    ++mInputTicks;
+    if ((tick + 1) % mInfo.sendInterval != 0) return;
+
+    const std::uint32_t count = std::min<std::uint32_t>(mInputTicks, NetInputRedundancy);
+    std::uint8_t buffer[16];
+    BitWriter writer(buffer, sizeof(buffer));
+    writer.WriteBits(static_cast<std::uint32_t>(NetPacket::Input), 8);
+    writer.WriteBool(mHasState);
+    writer.WriteBits(mLatest, 16);
+    writer.WriteBits(tick, 32);
+    writer.WriteBits(count, 4);
+    for (std::uint32_t t = tick + 1 - count; t != tick + 1; ++t) {
+        writer.WriteBits(mRecentButtons[t % NetInputRedundancy], 3);
+    }
+    mSocket.Send(mServer, buffer, writer.GetBytesWritten(), nowMs);
+}
@@ -0,0 +1,250 @@
+#include "../include/NetProtocol.hpp"
+#include "../include/NetSocket.hpp"
+#include "../include/Level.hpp"
+#include <algorithm>
+#include <bit>
+#include <limits>
+
+namespace {
+
+// Worst case for one new projectile: a 5-byte id delta, x, y and the team bit
+constexpr std::size_t MaxProjectileBits = 40 + 16 + 16 + 1;
+
+// Least one new projectile can take: a 1-byte id delta, x, y and the team bit
+constexpr std::size_t MinProjectileBits = 8 + 16 + 16 + 1;
+
+// Bits of alive-word `word` that are real slots, for a grid of `slots` slots
+std::uint64_t SlotMask(std::size_t word, std::size_t slots) {
+    const std::size_t used = slots - word * 64;
+    return used >= 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << used) - 1;
+}
+
+std::uint32_t ToWire16(std::int32_t value) {
+    const std::int32_t clamped = std::clamp<std::int32_t>(value, std::numeric_limits<std::int16_t>::min(),
+                                                          std::numeric_limits<std::int16_t>::max());
+    return static_cast<std::uint16_t>(clamped);
+}
+
+std::int32_t FromWire16(std::uint32_t value) {
+    return static_cast<std::int16_t>(static_cast<std::uint16_t>(value));
+}
+
+} // namespace
+
+void NetWorldState::ResetSlots(std::uint16_t columnCount, std::uint16_t rowCount) {
+    columns = columnCount;
+    rows = rowCount;
+    const std::size_t slots = static_cast<std::size_t>(columns) * rows;
+    alive.resize((slots + 63) / 64);
+    for (std::size_t word = 0; word < alive.size(); ++word) {
+        alive[word] = SlotMask(word, slots);
+    }
+}
+
+void EncodeWorldState(const NetWorldState& state, const NetWorldState* baseline, BitWriter& writer,
+                      NetWorldState& sent) {
+    sent.sequence = state.sequence;
+    sent.tick = state.tick;
+    if (baseline) {
+        writer.WriteVarUint(state.tick - baseline->tick);
+    } else {
+        writer.WriteBits(state.tick, 32);
+    }
+
+    // A new wave sends its layout once; after that only the origin moves
+    const bool sameWave = baseline && baseline->wave == state.wave;
+    writer.WriteBool(sameWave);
+    if (!sameWave) {
+        writer.WriteBits(state.wave, 16);
+        writer.WriteBits(state.prefab, 8);
+        writer.WriteBits(state.columns, 16);
+        writer.WriteBits(state.rows, 16);
+        writer.WriteVarInt(state.spacingX);
+        writer.WriteVarInt(state.spacingY);
+    }
+    writer.WriteVarInt(state.originX - (sameWave ? baseline->originX : 0));
+    writer.WriteVarInt(state.originY - (sameWave ? baseline->originY : 0));
+    writer.WriteBool(state.moveRight);
+
+    // Slots whose alive bit differs from the baseline's (or from a full new wave),
+    // as gaps between their indices
+    const std::size_t slots = static_cast<std::size_t>(state.columns) * state.rows;
+    auto flips = [&](std::size_t word) {
+        const std::uint64_t before = sameWave ? baseline->alive[word] : SlotMask(word, slots);
+        return state.alive[word] ^ before;
+    };
+    std::uint32_t flipCount = 0;
+    for (std::size_t word = 0; word < state.alive.size(); ++word) {
+        flipCount += static_cast<std::uint32_t>(std::popcount(flips(word)));
+    }
+    writer.WriteVarUint(flipCount);
+    std::size_t next = 0;
+    for (std::size_t word = 0; word < state.alive.size(); ++word) {
+        for (std::uint64_t bits = flips(word); bits != 0; bits &= bits - 1) {
+            const std::size_t slot = word * 64 + static_cast<std::size_t>(std::countr_zero(bits));
+            writer.WriteVarUint(static_cast<std::uint32_t>(slot - next));
+            next = slot + 1;
+        }
+    }
+
+    sent.wave = state.wave;
+    sent.prefab = state.prefab;
+    sent.columns = state.columns;
+    sent.rows = state.rows;
+    sent.spacingX = state.spacingX;
+    sent.spacingY = state.spacingY;
+    sent.originX = state.originX;
+    sent.originY = state.originY;
+    sent.moveRight = state.moveRight;
+    sent.alive.assign(state.alive.begin(), state.alive.end());
+
+    for (int i = 0; i < NetMaxPlayers; ++i) {
+        const NetPlayerState& player = state.players[i];
+        const NetPlayerState before = baseline ? baseline->players[i] : NetPlayerState{};
+        const bool changed = player != before;
+        writer.WriteBool(changed);
+        if (changed) {
+            writer.WriteBool(player.connected);
+            writer.WriteBool(player.alive);
+            writer.WriteVarInt(player.x - before.x);
+            writer.WriteVarInt(player.y - before.y);
+        }
+    }
+    sent.players = state.players;
+
+    // Projectiles: both lists are sorted by id, so one merge finds the ones that
+    // are gone and the ones that are new. Known projectiles cost nothing, since the
+    // receiver moves them itself; new ids are always above every baseline id.
+    static const std::vector<NetProjectile> none;
+    const std::vector<NetProjectile>& known = baseline ? baseline->projectiles : none;
+    std::uint32_t removedCount = 0;
+    std::uint32_t addedCount = 0;
+    for (std::size_t s = 0, b = 0; s < state.projectiles.size() || b < known.size();) {
+        if (b == known.size() || (s < state.projectiles.size() && state.projectiles[s].id < known[b].id)) {
+            ++addedCount;
+            ++s;
+        } else if (s == state.projectiles.size() || known[b].id < state.projectiles[s].id) {
+            ++removedCount;
+            ++b;
+        } else {
+            ++s;
+            ++b;
+        }
+    }
+
+    writer.WriteVarUint(removedCount);
+    sent.projectiles.clear();
+    next = 0;
+    for (std::size_t s = 0, b = 0; b < known.size();) {
+        if (s < state.projectiles.size() && state.projectiles[s].id < known[b].id) {
+            ++s;
+        } else if (s == state.projectiles.size() || known[b].id < state.projectiles[s].id) {
+            writer.WriteVarUint(static_cast<std::uint32_t>(b - next));
+            next = b + 1;
+            ++b;
+        } else {
+            sent.projectiles.push_back(known[b]);
+            ++s;
+            ++b;
+        }
+    }
+
+    // As many new projectiles as fit; the rest go out in a later snapshot
+    const std::size_t room = writer.GetBitsLeft() > 40 ? (writer.GetBitsLeft() - 40) / MaxProjectileBits : 0;
+    const auto sendCount = static_cast<std::uint32_t>(std::min<std::size_t>(addedCount, room));
+    writer.WriteVarUint(sendCount);
+    std::uint32_t previousId = 0;
+    const std::size_t firstAdded = state.projectiles.size() - addedCount;
+    for (std::size_t s = firstAdded; s < firstAdded + sendCount; ++s) {
+        const NetProjectile& projectile = state.projectiles[s];
+        writer.WriteVarUint(projectile.id - previousId);
+        writer.WriteBits(ToWire16(projectile.x), 16);
+        writer.WriteBits(ToWire16(projectile.y), 16);
+        writer.WriteBool(projectile.team == ProjectileTeam::Enemy);
+        previousId = projectile.id;
+
+        sent.projectiles.push_back({projectile.id, FromWire16(ToWire16(projectile.x)),
+                                    FromWire16(ToWire16(projectile.y)), state.tick, projectile.team});
+    }
+}
+
+bool DecodeWorldState(BitReader& reader, const NetWorldState* baseline, NetWorldState& state) {
+    state.tick = baseline ? baseline->tick + reader.ReadVarUint() : reader.ReadBits(32);
+
+    const bool sameWave = reader.ReadBool();
+    if (sameWave && !baseline) return false;
+    if (sameWave) {
+        state.wave = baseline->wave;
+        state.prefab = baseline->prefab;
+        state.columns = baseline->columns;
+        state.rows = baseline->rows;
+        state.spacingX = baseline->spacingX;
+        state.spacingY = baseline->spacingY;
+        state.alive.assign(baseline->alive.begin(), baseline->alive.end());
+    } else {
+        state.wave = static_cast<std::uint16_t>(reader.ReadBits(16));
+        state.prefab = static_cast<std::uint8_t>(reader.ReadBits(8));
+        const auto columns = static_cast<std::uint16_t>(reader.ReadBits(16));
+        const auto rows = static_cast<std::uint16_t>(reader.ReadBits(16));
+        state.spacingX = reader.ReadVarInt();
+        state.spacingY = reader.ReadVarInt();
+        if (reader.HasOverflowed()) return false;
+        // Checked before the slots are sized, so damage can't ask for a huge grid
+        if (static_cast<std::size_t>(columns) * rows > LevelMaxWaveSlots) return false;
+        state.ResetSlots(columns, rows);
+    }
+    state.originX = (sameWave ? baseline->originX : 0) + reader.ReadVarInt();
+    state.originY = (sameWave ? baseline->originY : 0) + reader.ReadVarInt();
+    state.moveRight = reader.ReadBool();
+
+    const std::size_t slots = static_cast<std::size_t>(state.columns) * state.rows;
+    const std::uint32_t flipCount = reader.ReadVarUint();
+    if (flipCount > slots) return false;
+    std::size_t next = 0;
+    for (std::uint32_t i = 0; i < flipCount; ++i) {
+        const std::size_t slot = next + reader.ReadVarUint();
+        if (slot >= slots) return false;
+        state.alive[slot >> 6] ^= std::uint64_t{1} << (slot & 63);
+        next = slot + 1;
+    }
+
+    for (int i = 0; i < NetMaxPlayers; ++i) {
+        const NetPlayerState before = baseline ? baseline->players[i] : NetPlayerState{};
+        NetPlayerState& player = state.players[i];
+        player = before;
+        if (reader.ReadBool()) {
+            player.connected = reader.ReadBool();
+            player.alive = reader.ReadBool();
+            player.x = before.x + reader.ReadVarInt();
+            player.y = before.y + reader.ReadVarInt();
+        }
+    }
+
+    static const std::vector<NetProjectile> none;
+    const std::vector<NetProjectile>& known = baseline ? baseline->projectiles : none;
+    const std::uint32_t removedCount = reader.ReadVarUint();
+    if (removedCount > known.size()) return false;
+    state.projectiles.clear();
+    std::size_t kept = 0;
+    for (std::uint32_t i = 0; i < removedCount; ++i) {
+        const std::size_t removed = kept + reader.ReadVarUint();
+        if (removed >= known.size()) return false;
+        state.projectiles.insert(state.projectiles.end(), known.begin() + kept, known.begin() + removed);
+        kept = removed + 1;
+    }
+    state.projectiles.insert(state.projectiles.end(), known.begin() + kept, known.end());
+
+    const std::uint32_t addedCount = reader.ReadVarUint();
+    // A count no packet could hold is damage
+    if (addedCount > NetMaxPacket * 8 / MinProjectileBits) return false;
+    std::uint32_t id = 0;
+    for (std::uint32_t i = 0; i < addedCount; ++i) {
+        id += reader.ReadVarUint();
+        const std::int32_t x = FromWire16(reader.ReadBits(16));
+        const std::int32_t y = FromWire16(reader.ReadBits(16));
+        const ProjectileTeam team = reader.ReadBool() ? ProjectileTeam::Enemy : ProjectileTeam::Player;
+        if (!state.projectiles.empty() && state.projectiles.back().id >= id) return false;
+        state.projectiles.push_back({id, x, y, state.tick, team});
+    }
+    return !reader.HasOverflowed();
+}
@@ -0,0 +1,214 @@
+#include "../include/NetServer.hpp"
+#include "../include/Log.hpp"
+#include "../include/Profiler.hpp"
+#include <cstring>
+
+bool NetServer::Open(std::uint16_t port, const NetServerInfo& info) {
+    mInfo = info;
+    for (Client& client : mClients) {
+        client.connected = false;
+    }
+    if (!mSocket.Open(port)) return false;
+    LOG_INFO(Net, "Server listening on UDP port %u", static_cast<unsigned>(mSocket.GetPort()));
+    return true;
+}
+
+void NetServer::Close() {
+    mSocket.Close();
+    for (Client& client : mClients) {
+        client.connected = false;
+    }
+}
+
+int NetServer::FindClient(const NetAddress& address) const {
+    for (int slot = 1; slot < NetMaxPlayers; ++slot) {
+        if (mClients[slot].connected && mClients[slot].address == address) return slot;
+    }
+    return -1;
+}
+
+int NetServer::GetClientCount() const {
+    int count = 0;
+    for (int slot = 1; slot < NetMaxPlayers; ++slot) {
+        count += mClients[slot].connected ? 1 : 0;
+    }
+    return count;
+}
+
+void NetServer::Receive(double nowMs) {
+    PROFILE_SCOPE("Net.Receive");
+
+    std::uint8_t buffer[NetMaxPacket];
+    NetAddress from;
+    while (std::size_t size = mSocket.Receive(from, buffer, sizeof(buffer))) {
+        BitReader reader(buffer, size);
+        const auto type = static_cast<NetPacket>(reader.ReadBits(8));
+        if (type == NetPacket::Connect) {
+            HandleConnect(from, reader, nowMs);
+            continue;
+        }
+
+        const int slot = FindClient(from);
+        if (slot < 0) continue;
+        Client& client = mClients[slot];
+        client.lastHeardMs = nowMs;
+
+        if (type == NetPacket::Input) {
+            HandleInput(client, reader);
+        } else if (type == NetPacket::Disconnect) {
+            LOG_INFO(Net, "Player %d left", slot);
+            client.connected = false;
+        }
+    }
+
+    for (int slot = 1; slot < NetMaxPlayers; ++slot) {
+        Client& client = mClients[slot];
+        if (client.connected && nowMs - client.lastHeardMs > TimeoutMs) {
+            LOG_INFO(Net, "Player %d timed out", slot);
+            client.connected = false;
+        }
+    }
+}
+
+void NetServer::HandleConnect(const NetAddress& from, BitReader& reader, double nowMs) {
+    if (reader.ReadBits(32) != NetProtocolId || reader.HasOverflowed()) return;
+
+    // A client that's already in lost our accept; it gets the same slot again
+    int slot = FindClient(from);
+    if (slot < 0) {
+        for (int free = 1; free < NetMaxPlayers && slot < 0; ++free) {
+            if (!mClients[free].connected) slot = free;
+        }
+        if (slot < 0) {
+            const std::uint8_t reject = static_cast<std::uint8_t>(NetPacket::Reject);
+            mSocket.Send(from, &reject, 1, nowMs);
+            return;
+        }
+
+        Client& client = mClients[slot];
+        client.connected = true;
+        client.address = from;
+        client.inputHead = 0;
+        client.inputCount = 0;
+        client.hasInput = false;
+        client.buttons = 0;
+        client.hasApplied = false;
+        client.hasAck = false;
+        LOG_INFO(Net, "Player %d joined from %u.%u.%u.%u:%u", slot, from.ip >> 24, (from.ip >> 16) & 0xFF,
+                 (from.ip >> 8) & 0xFF, from.ip & 0xFF, static_cast<unsigned>(from.port));
+    }
+    mClients[slot].lastHeardMs = nowMs;
+
+    std::uint8_t buffer[128];
+    BitWriter writer(buffer, sizeof(buffer));
+    std::uint32_t rate = 0;
+    std::memcpy(&rate, &mInfo.simulationRate, sizeof(rate));
+    writer.WriteBits(static_cast<std::uint32_t>(NetPacket::Accept), 8);
+    writer.WriteBits(static_cast<std::uint32_t>(slot), 8);
+    writer.WriteBits(mInfo.sendInterval, 8);
+    writer.WriteBits(rate, 32);
+    for (char c : mInfo.level) {
+        writer.WriteBits(static_cast<std::uint8_t>(c), 8);
+    }
+    mSocket.Send(from, buffer, writer.GetBytesWritten(), nowMs);
+}
+
+void NetServer::HandleInput(Client& client, BitReader& reader) {
+    const bool hasAck = reader.ReadBool();
+    const auto ack = static_cast<std::uint16_t>(reader.ReadBits(16));
+    const std::uint32_t lastTick = reader.ReadBits(32);
+    const std::uint32_t count = reader.ReadBits(4);
+    std::uint8_t buttons[NetInputRedundancy] = {};
+    for (std::uint32_t i = 0; i < count && i < NetInputRedundancy; ++i) {
+        buttons[i] = static_cast<std::uint8_t>(reader.ReadBits(3));
+    }
+    if (reader.HasOverflowed() || count == 0 || count > NetInputRedundancy) return;
+
+    if (hasAck && (!client.hasAck || SequenceNewer(ack, client.ackedSequence))) {
+        client.hasAck = true;
+        client.ackedSequence = ack;
+    }
+
+    // Packets overlap, so only ticks past the newest one queued are new
+    for (std::uint32_t i = 0; i < count; ++i) {
+        const std::uint32_t tick = lastTick - (count - 1) + i;
+        if (client.hasInput && static_cast<std::int32_t>(tick - client.lastQueuedTick) <= 0) continue;
+
+        if (client.inputCount == client.inputs.size()) {
+            client.inputHead = (client.inputHead + 1) % client.inputs.size();
+            --client.inputCount;
+        }
+        client.inputs[(client.inputHead + client.inputCount) % client.inputs.size()] = {tick, buttons[i]};
+        ++client.inputCount;
+        client.lastQueuedTick = tick;
+        client.hasInput = true;
+    }
+}
+
+std::uint8_t NetServer::NextInput(int slot) {
+    Client& client = mClients[slot];
+    if (!client.connected) return 0;
+
+    // Fallen behind (a burst after a stall): skip ahead rather than lag forever
+    while (client.inputCount > MaxQueuedInputs) {
+        client.inputHead = (client.inputHead + 1) % client.inputs.size();
+        --client.inputCount;
+    }
+    if (client.inputCount > 0) {
+        const TickInput& input = client.inputs[client.inputHead];
+        client.buttons = input.buttons;
+        client.appliedTick = input.tick;
+        client.hasApplied = true;
+        client.inputHead = (client.inputHead + 1) % client.inputs.size();
+        --client.inputCount;
+    }
+    return client.buttons;
+}
+
+const NetWorldState* NetServer::FindSent(int slot, std::uint16_t sequence) const {
+    const Client& client = mClients[slot];
+    const NetWorldState& sent = client.sent[sequence % HistorySize];
+    return client.connected && sent.sequence == sequence ? &sent : nullptr;
+}
+
+void NetServer::SendSnapshots(const NetWorldState& state, double nowMs) {
+    PROFILE_SCOPE("Net.Send");
+
+    const std::uint16_t sequence = mNextSequence++;
+    std::uint8_t buffer[NetMaxPacket];
+    for (int slot = 1; slot < NetMaxPlayers; ++slot) {
+        Client& client = mClients[slot];
+        if (!client.connected) continue;
+
+        // The ack must still be in the history, and not in the entry about to be overwritten
+        const NetWorldState* baseline = nullptr;
+        if (client.hasAck && static_cast<std::uint16_t>(sequence - client.ackedSequence) < HistorySize) {
+            baseline = FindSent(slot, client.ackedSequence);
+        }
+
+        NetWorldState& sent = client.sent[sequence % HistorySize];
+        auto encode = [&](const NetWorldState* against) {
+            BitWriter writer(buffer, sizeof(buffer));
+            writer.WriteBits(static_cast<std::uint32_t>(NetPacket::Snapshot), 8);
+            writer.WriteBits(sequence, 16);
+            writer.WriteBool(against != nullptr);
+            if (against) writer.WriteBits(against->sequence, 16);
+            writer.WriteBool(client.hasApplied);
+            if (client.hasApplied) writer.WriteBits(client.appliedTick, 32);
+            EncodeWorldState(state, against, writer, sent);
+            return writer.HasOverflowed() ? 0 : writer.GetBytesWritten();
+        };
+
+        // An old baseline can leave too many removals to fit; a full snapshot always
+        // fits the new projectiles it has room for
+        std::size_t size = encode(baseline);
+        if (size == 0 && baseline) size = encode(nullptr);
+        if (size == 0) {
+            LOG_WARN(Net, "World state for player %d doesn't fit in one packet", slot);
+            sent.sequence = static_cast<std::uint16_t>(sequence + HistorySize); // never a baseline
+            continue;
+        }
+        sent.sequence = sequence;
+        mSocket.Send(client.address, buffer, size, nowMs);
+    }
+}
@@ -0,0 +1,180 @@
+#include "../include/NetSocket.hpp"
+#include "../include/Log.hpp"
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+#ifdef _WIN32
+using SocketHandle = SOCKET;
+
+bool StartSockets() {
+    static const bool started = [] {
+        WSADATA data;
+        return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+    }();
+    return started;
+}
+
+void CloseSocket(SocketHandle socket) { closesocket(socket); }
+
+bool MakeNonBlocking(SocketHandle socket) {
+    u_long nonBlocking = 1;
+    return ioctlsocket(socket, FIONBIO, &nonBlocking) == 0;
+}
+#else
+using SocketHandle = int;
+
+bool StartSockets() { return true; }
+
+void CloseSocket(SocketHandle socket) { close(socket); }
+
+bool MakeNonBlocking(SocketHandle socket) {
+    const int flags = fcntl(socket, F_GETFL, 0);
+    return flags != -1 && fcntl(socket, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+#endif
+
+sockaddr_in ToSockaddr(const NetAddress& address) {
+    sockaddr_in result{};
+    result.sin_family = AF_INET;
+    result.sin_addr.s_addr = htonl(address.ip);
+    result.sin_port = htons(address.port);
+    return result;
+}
+
+} // namespace
+
+bool NetAddress::Parse(const char* text, NetAddress& address) {
+    unsigned a = 0, b = 0, c = 0, d = 0, port = 0;
+    if (std::sscanf(text, "localhost:%u", &port) == 1) {
+        a = 127;
+        d = 1;
+    } else if (std::sscanf(text, "%u.%u.%u.%u:%u", &a, &b, &c, &d, &port) != 5) {
+        return false;
+    }
+    if (a > 255 || b > 255 || c > 255 || d > 255 || port == 0 || port > 65535) return false;
+
+    address.ip = (a << 24) | (b << 16) | (c << 8) | d;
+    address.port = static_cast<std::uint16_t>(port);
+    return true;
+}
+
+NetSocket::~NetSocket() {
+    Close();
+}
+
+bool NetSocket::Open(std::uint16_t port) {
+    Close();
+    if (!StartSockets()) {
+        LOG_ERROR(Net, "Failed to start sockets");
+        return false;
+    }
+
+    SocketHandle handle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    sockaddr_in local{};
+    local.sin_family = AF_INET;
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    local.sin_port = htons(port);
+    socklen_t length = sizeof(local);
+    if (handle == static_cast<SocketHandle>(InvalidSocket) ||
+        bind(handle, reinterpret_cast<const sockaddr*>(&local), sizeof(local)) != 0 ||
+        !MakeNonBlocking(handle) ||
+        getsockname(handle, reinterpret_cast<sockaddr*>(&local), &length) != 0) {
+        LOG_ERROR(Net, "Failed to open UDP port %u", static_cast<unsigned>(port));
+        if (handle != static_cast<SocketHandle>(InvalidSocket)) CloseSocket(handle);
+        return false;
+    }
+
+    mSocket = static_cast<std::intptr_t>(handle);
+    mPort = ntohs(local.sin_port);
+    // Room for a second's worth of delayed packets before the queue grows
+    mDelayed.reserve(256);
+    mBytesSent = 0;
+    mPacketsSent = 0;
+    mPacketsDropped = 0;
+    return true;
+}
+
+void NetSocket::Close() {
+    if (mSocket == InvalidSocket) return;
+    CloseSocket(static_cast<SocketHandle>(mSocket));
+    mSocket = InvalidSocket;
+    mDelayed.clear();
+}
+
+float NetSocket::NextRandom() {
+    mRandom ^= mRandom << 13;
+    mRandom ^= mRandom >> 17;
+    mRandom ^= mRandom << 5;
+    return static_cast<float>(mRandom >> 8) / static_cast<float>(1u << 24);
+}
+
+void NetSocket::Send(const NetAddress& to, const void* data, std::size_t size, double nowMs) {
+    if (size > NetMaxPacket) {
+        LOG_ERROR(Net, "Dropping a %zu-byte packet, the limit is %zu", size, NetMaxPacket);
+        return;
+    }
+    if (mConditions.lossPercent > 0.0f && NextRandom() * 100.0f < mConditions.lossPercent) {
+        ++mPacketsDropped;
+        return;
+    }
+    if (mConditions.latencyMs <= 0.0f && mConditions.jitterMs <= 0.0f) {
+        SendNow(to, data, size);
+        return;
+    }
+
+    Delayed& packet = mDelayed.emplace_back();
+    packet.dueMs = nowMs + mConditions.latencyMs + NextRandom() * mConditions.jitterMs;
+    packet.to = to;
+    packet.size = static_cast<std::uint16_t>(size);
+    std::memcpy(packet.data, data, size);
+}
+
+void NetSocket::Flush(double nowMs) {
+    // Swap-remove whatever is due; jitter may reorder packets, as a real network would
+    for (std::size_t i = 0; i < mDelayed.size();) {
+        if (mDelayed[i].dueMs <= nowMs) {
+            SendNow(mDelayed[i].to, mDelayed[i].data, mDelayed[i].size);
+            mDelayed[i] = mDelayed.back();
+            mDelayed.pop_back();
+        } else {
+            ++i;
+        }
+    }
+}
+
+void NetSocket::SendNow(const NetAddress& to, const void* data, std::size_t size) {
+    if (mSocket == InvalidSocket) return;
+    const sockaddr_in address = ToSockaddr(to);
+    const auto sent = sendto(static_cast<SocketHandle>(mSocket), static_cast<const char*>(data),
+                             static_cast<int>(size), 0, reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+    if (sent < 0) return;
+    mBytesSent += size;
+    ++mPacketsSent;
+}
+
+std::size_t NetSocket::Receive(NetAddress& from, void* buffer, std::size_t size) {
+    if (mSocket == InvalidSocket) return 0;
+
+    sockaddr_in address{};
+    socklen_t length = sizeof(address);
+    const auto received = recvfrom(static_cast<SocketHandle>(mSocket), static_cast<char*>(buffer),
+                                   static_cast<int>(size), 0, reinterpret_cast<sockaddr*>(&address), &length);
+    if (received <= 0) return 0;
+
+    from.ip = ntohl(address.sin_addr.s_addr);
+    from.port = ntohs(address.sin_port);
+    return static_cast<std::size_t>(received);
+}
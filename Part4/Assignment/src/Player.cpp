@@ -2,71 +2,53 @@
 #include "Player.hpp"
 #include "InputComponent.hpp"
 #include "TextureComponent.hpp"
+#include "Log.hpp"
 
-Player::Player(SDL_Renderer* renderer) {
+Player::Player(ProjectilePool& projectiles)
+    : mProjectiles(&projectiles), mLauncher(projectiles.CreateLauncher(ProjectileTeam::Player)) {
     mRenderable = true;
 
     // Create transform component first
-    auto transform = std::make_shared<TransformComponent>();
-    AddComponent(ComponentType::TransformComponent, transform);
+    TransformComponent transform;
     
     // Set initial transform size - important for rendering!
-    transform->SetX(350.0f);
-    transform->SetY(500.0f);
-    transform->SetW(40.0f); // Make sure to set width and height
-    transform->SetH(40.0f);
+    transform.SetX(350.0f);
+    transform.SetY(500.0f);
+    transform.SetW(40.0f); // Make sure to set width and height
+    transform.SetH(40.0f);
+    AddComponent(transform);
     
-    std::cout << "Player transform initialized at: " << transform->GetX() << ", " << transform->GetY() 
-              << " with size: " << transform->GetW() << "x" << transform->GetH() << std::endl;
+    LOG_DEBUG(Entity, "Player transform initialized at: %.0f, %.0f with size: %.0fx%.0f",
+              transform.GetX(), transform.GetY(), transform.GetW(), transform.GetH());
 
     // Create texture component
-    auto texture = std::make_shared<TextureComponent>();
-    texture->CreateTextureComponent(renderer, "Assets/Spaceship.bmp");
-    AddComponent(ComponentType::TextureComponent, std::static_pointer_cast<Component>(texture));
-
-    // Create projectile
-    auto projectile = std::make_shared<Projectile>();
-    
-    // Create transform for projectile
-    auto projTransform = std::make_shared<TransformComponent>();
-    projTransform->SetW(6.0f);  // Set width and height
-    projTransform->SetH(20.0f);
-    projectile->AddComponent(ComponentType::TransformComponent, projTransform);
-    
-    // Create texture for projectile
-    auto projTexture = std::make_shared<TextureComponent>();
-    projTexture->CreateTextureComponent(renderer, "Assets/Projectile.bmp");
-    projectile->AddComponent(ComponentType::TextureComponent, std::static_pointer_cast<Component>(projTexture));
-
-    mProjectile = projectile;
+    TextureComponent texture;
+    texture.CreateTextureComponentAsync("Assets/Spaceship.bmp");
+    AddComponent(texture);
 }
 
 Player::~Player() {}
 
 void Player::Input(float deltaTime) {
-    for (auto& [_, component] : mComponents) {
-        component->Input(deltaTime);
-    }
+    ForEachComponent([&](Component& component) {
+        component.Input(deltaTime);
+    });
 }
 
 void Player::Update(float deltaTime) {
-    for (auto& [_, component] : mComponents) {
-        component->Update(deltaTime);
-    }
-
-    mProjectile->Update(deltaTime);
+    ForEachComponent([&](Component& component) {
+        component.Update(deltaTime);
+    });
 }
 
-void Player::Render(SDL_Renderer* renderer) {
+void Player::Render(SpriteBatch& batch) {
     if (!mRenderable) return;
 
-    for (auto& [_, component] : mComponents) {
-        component->Render(renderer);
-    }
-
-    mProjectile->Render(renderer);
+    ForEachComponent([&](Component& component) {
+        component.Render(batch);
+    });
 }
 
-std::shared_ptr<Projectile> Player::GetProjectile() {
-    return mProjectile;
+void Player::Launch(float x, float y, float minLaunchTime) {
+    mProjectiles->Launch(mLauncher, x, y, true, minLaunchTime);
 }
\ No newline at end of file
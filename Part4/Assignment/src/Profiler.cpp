@@ -0,0 +1,162 @@
+#include "../include/Profiler.hpp"
+#include "../include/Log.hpp"
+#include <algorithm>
+
+Profiler* Profiler::mInstance = nullptr;
+
+Profiler& Profiler::Instance() {
+    if (mInstance == nullptr) {
+        mInstance = new Profiler();
+    }
+    return *mInstance;
+}
+
+Profiler::ThreadBuffer& Profiler::LocalBuffer() {
+    // Buffers are owned by the profiler so they outlive the threads that fill them
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (buffer == nullptr) {
+        std::lock_guard<std::mutex> lock(mBuffersMutex);
+        mBuffers.push_back(std::make_unique<ThreadBuffer>());
+        buffer = mBuffers.back().get();
+        buffer->events.reserve(1024); // a frame's worth, so recording doesn't allocate mid-frame
+        buffer->threadId = static_cast<std::uint32_t>(mBuffers.size());
+    }
+    return *buffer;
+}
+
+void Profiler::Record(const char* name, std::int64_t start, std::int64_t end) {
+    ThreadBuffer& buffer = LocalBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex); // uncontended except during EndFrame
+    if (buffer.events.size() < MaxEventsPerThread) {
+        buffer.events.push_back({name, start, end});
+    }
+}
+
+void Profiler::BeginFrame() {
+    mFrameStart = Now();
+}
+
+void Profiler::EndFrame() {
+    if (mFrameStart != 0) {
+        Record("Frame", mFrameStart, Now());
+        mFrameStart = 0;
+    }
+
+    const bool capturing = !mCapturePath.empty() && mFrameIndex >= mCaptureFirst && mFrameIndex < mCaptureEnd;
+
+    std::lock_guard<std::mutex> buffersLock(mBuffersMutex);
+    for (auto& buffer : mBuffers) {
+        // Copy rather than swap, so each thread keeps the capacity it has grown into
+        {
+            std::lock_guard<std::mutex> lock(buffer->mutex);
+            mScratch.assign(buffer->events.begin(), buffer->events.end());
+            buffer->events.clear();
+        }
+
+        for (const Event& event : mScratch) {
+            ZoneStats& zone = mZones[event.name];
+            if (zone.frameMs.capacity() == 0) {
+                zone.frameMs.reserve(HistoryFrames);
+            }
+            if (!zone.seenThisFrame) {
+                zone.seenThisFrame = true;
+                zone.currentFrame = 0;
+            }
+            zone.currentFrame += event.end - event.start;
+
+            if (capturing) {
+                mCaptured.push_back({event, buffer->threadId});
+            }
+        }
+    }
+
+    for (auto& [name, zone] : mZones) {
+        if (!zone.seenThisFrame) continue;
+        zone.seenThisFrame = false;
+
+        const float ms = static_cast<float>(zone.currentFrame) / 1e6f;
+        if (zone.frameMs.size() < HistoryFrames) {
+            zone.frameMs.push_back(ms);
+        } else {
+            zone.frameMs[zone.next] = ms;
+        }
+        zone.next = (zone.next + 1) % HistoryFrames;
+    }
+
+    ++mFrameIndex;
+    if (!mCapturePath.empty() && mFrameIndex == mCaptureEnd) {
+        WriteCapture();
+    }
+}
+
+void Profiler::RequestCapture(const std::string& filePath, std::uint64_t firstFrame, std::uint64_t frameCount) {
+    mCapturePath = filePath;
+    mCaptureFirst = firstFrame;
+    mCaptureEnd = firstFrame + frameCount;
+    mCaptured.clear();
+}
+
+void Profiler::WriteCapture() {
+    FILE* file = std::fopen(mCapturePath.c_str(), "w");
+    if (!file) {
+        LOG_ERROR(Core, "Failed to open trace file %s", mCapturePath.c_str());
+    } else {
+        // Timestamps are microseconds from the first captured zone
+        std::int64_t origin = mCaptured.empty() ? 0 : mCaptured.front().event.start;
+        for (const CapturedEvent& captured : mCaptured) {
+            origin = std::min(origin, captured.event.start);
+        }
+
+        std::fprintf(file, "{\"traceEvents\":[\n");
+        for (std::size_t i = 0; i < mCaptured.size(); ++i) {
+            const Event& event = mCaptured[i].event;
+            std::fprintf(file, "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}%s\n",
+                         event.name, mCaptured[i].threadId,
+                         (event.start - origin) / 1000.0, (event.end - event.start) / 1000.0,
+                         i + 1 < mCaptured.size() ? "," : "");
+        }
+        std::fprintf(file, "],\"displayTimeUnit\":\"ms\"}\n");
+        std::fclose(file);
+        LOG_INFO(Core, "Wrote %zu trace events to %s", mCaptured.size(), mCapturePath.c_str());
+    }
+
+    mCapturePath.clear();
+    mCaptured.clear();
+    mCaptured.shrink_to_fit();
+}
+
+void Profiler::Report(FILE* out) const {
+    // Sort by name so nested zones ("Update", "Update.Enemies") print together
+    std::vector<std::pair<std::string, const ZoneStats*>> zones;
+    for (const auto& [name, zone] : mZones) {
+        zones.emplace_back(name, &zone);
+    }
+    std::sort(zones.begin(), zones.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    std::fprintf(out, "%-24s %8s %10s %10s %10s\n", "zone (ms/frame)", "frames", "min", "avg", "p99");
+    std::vector<float> sorted;
+    for (const auto& [name, zone] : zones) {
+        if (zone->frameMs.empty()) continue;
+
+        sorted = zone->frameMs;
+        std::sort(sorted.begin(), sorted.end());
+        double sum = 0.0;
+        for (float ms : sorted) sum += ms;
+        const std::size_t p99 = std::min(sorted.size() - 1, sorted.size() * 99 / 100);
+
+        std::fprintf(out, "%-24s %8zu %10.3f %10.3f %10.3f\n", name.c_str(), sorted.size(),
+                     sorted.front(), sum / sorted.size(), sorted[p99]);
+    }
+}
+
+void Profiler::Reset() {
+    std::lock_guard<std::mutex> buffersLock(mBuffersMutex);
+    for (auto& buffer : mBuffers) {
+        std::lock_guard<std::mutex> lock(buffer->mutex);
+        buffer->events.clear();
+    }
+    mZones.clear();
+    mFrameIndex = 0;
+    mCapturePath.clear();
+    mCaptured.clear();
+}
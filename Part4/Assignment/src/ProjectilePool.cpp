@@ -0,0 +1,181 @@
+#include "../include/ProjectilePool.hpp"
+#include "../include/Snapshot.hpp"
+#include <algorithm>
+
+ProjectilePool::ProjectilePool(std::size_t capacity)
+    : mX(capacity), mY(capacity), mPrevX(capacity), mPrevY(capacity), mW(capacity), mH(capacity),
+      mVX(capacity), mVY(capacity), mLife(capacity),
+      mOwner(capacity), mTeam(capacity), mId(capacity) {}
+
+ProjectileLauncher ProjectilePool::CreateLauncher(ProjectileTeam team) {
+    ProjectileLauncher launcher;
+    launcher.owner = mNextOwner++;
+    launcher.team = team;
+    launcher.lastLaunchTime = GetTicks();
+    return launcher;
+}
+
+bool ProjectilePool::Launch(ProjectileLauncher& launcher, float x, float y, bool directionUp, float minLaunchTime) {
+    Uint64 now = GetTicks();
+    if (now - launcher.lastLaunchTime < minLaunchTime) return false;
+
+    float vy = directionUp ? -Speed : Speed;
+    if (!Spawn(x, y, 0.0f, vy, launcher.owner, launcher.team)) return false;
+
+    launcher.lastLaunchTime = now;
+    return true;
+}
+
+bool ProjectilePool::Spawn(float x, float y, float vx, float vy, std::uint32_t owner, ProjectileTeam team) {
+    if (mCount == Capacity()) return false;
+
+    std::size_t i = mCount++;
+    mX[i] = x;
+    mY[i] = y;
+    mPrevX[i] = x;
+    mPrevY[i] = y;
+    mW[i] = Width;
+    mH[i] = Height;
+    mVX[i] = vx;
+    mVY[i] = vy;
+    mLife[i] = Lifetime;
+    mOwner[i] = owner;
+    mTeam[i] = team;
+    mId[i] = mNextId++;
+    return true;
+}
+
+void ProjectilePool::Despawn(std::size_t index) {
+    std::size_t last = --mCount;
+    if (index == last) return;
+
+    mX[index] = mX[last];
+    mY[index] = mY[last];
+    mPrevX[index] = mPrevX[last];
+    mPrevY[index] = mPrevY[last];
+    mW[index] = mW[last];
+    mH[index] = mH[last];
+    mVX[index] = mVX[last];
+    mVY[index] = mVY[last];
+    mLife[index] = mLife[last];
+    mOwner[index] = mOwner[last];
+    mTeam[index] = mTeam[last];
+    mId[index] = mId[last];
+}
+
+void ProjectilePool::QueueLaunch(ProjectileLauncher& launcher, float x, float y, bool directionUp, float minLaunchTime) {
+    std::lock_guard<std::mutex> lock(mLaunchMutex);
+    mLaunchQueue.push_back({&launcher, x, y, directionUp, minLaunchTime, static_cast<std::uint32_t>(mLaunchQueue.size())});
+}
+
+void ProjectilePool::FlushLaunches() {
+    // Same order as a stable sort by owner, without stable_sort's temporary buffer
+    std::sort(mLaunchQueue.begin(), mLaunchQueue.end(), [](const LaunchRequest& a, const LaunchRequest& b) {
+        if (a.launcher->owner != b.launcher->owner) return a.launcher->owner < b.launcher->owner;
+        return a.order < b.order;
+    });
+    for (const LaunchRequest& request : mLaunchQueue) {
+        Launch(*request.launcher, request.x, request.y, request.directionUp, request.minLaunchTime);
+    }
+    mLaunchQueue.clear();
+}
+
+void ProjectilePool::Update(float deltaTime) {
+    AdvanceClock(deltaTime);
+    Integrate(0, mCount, deltaTime);
+    RemoveExpired();
+}
+
+void ProjectilePool::Integrate(std::size_t begin, std::size_t end, float deltaTime) {
+    for (std::size_t i = begin; i < end; ++i) {
+        mX[i] += mVX[i] * deltaTime;
+        mY[i] += mVY[i] * deltaTime;
+        mLife[i] -= deltaTime;
+    }
+}
+
+void ProjectilePool::RemoveExpired() {
+    // Walk backwards so a swapped-in projectile has already been checked.
+    const float right = mBounds.x + mBounds.w;
+    const float bottom = mBounds.y + mBounds.h;
+    for (std::size_t i = mCount; i-- > 0;) {
+        if (mY[i] < mBounds.y || mY[i] > bottom || mX[i] < mBounds.x || mX[i] > right || mLife[i] <= 0.0f) {
+            Despawn(i);
+        }
+    }
+}
+
+void ProjectilePool::StorePrevious() {
+    std::copy(mX.begin(), mX.begin() + mCount, mPrevX.begin());
+    std::copy(mY.begin(), mY.begin() + mCount, mPrevY.begin());
+}
+
+void ProjectilePool::SaveState(SnapshotWriter& writer) const {
+    writer.Write(static_cast<std::uint32_t>(mCount));
+    writer.Write(mNextOwner);
+    writer.Write(mNextId);
+    writer.Write(mTime);
+    writer.WriteArray(mX.data(), mCount);
+    writer.WriteArray(mY.data(), mCount);
+    writer.WriteArray(mW.data(), mCount);
+    writer.WriteArray(mH.data(), mCount);
+    writer.WriteArray(mVX.data(), mCount);
+    writer.WriteArray(mVY.data(), mCount);
+    writer.WriteArray(mLife.data(), mCount);
+    writer.WriteArray(mOwner.data(), mCount);
+    writer.WriteArray(mTeam.data(), mCount);
+    writer.WriteArray(mId.data(), mCount);
+}
+
+bool ProjectilePool::LoadState(SnapshotReader& reader) {
+    std::uint32_t count = 0;
+    if (!reader.Read(count) || count > Capacity()) return false;
+
+    mCount = count;
+    reader.Read(mNextOwner);
+    reader.Read(mNextId);
+    reader.Read(mTime);
+    reader.ReadArray(mX.data(), mCount);
+    reader.ReadArray(mY.data(), mCount);
+    reader.ReadArray(mW.data(), mCount);
+    reader.ReadArray(mH.data(), mCount);
+    reader.ReadArray(mVX.data(), mCount);
+    reader.ReadArray(mVY.data(), mCount);
+    reader.ReadArray(mLife.data(), mCount);
+    reader.ReadArray(mOwner.data(), mCount);
+    reader.ReadArray(mTeam.data(), mCount);
+    reader.ReadArray(mId.data(), mCount);
+    mLaunchQueue.clear();
+    StorePrevious();
+    return reader.IsValid();
+}
+
+bool ProjectilePool::SkipState(SnapshotReader& reader) const {
+    std::uint32_t count = 0;
+    if (!reader.Read(count) || count > Capacity()) return false;
+
+    // One projectile's row of every array SaveState() writes
+    const std::size_t rowSize = sizeof(mX[0]) + sizeof(mY[0]) + sizeof(mW[0]) + sizeof(mH[0]) + sizeof(mVX[0]) +
+                                sizeof(mVY[0]) + sizeof(mLife[0]) + sizeof(mOwner[0]) + sizeof(mTeam[0]) +
+                                sizeof(mId[0]);
+    return reader.Skip(sizeof(mNextOwner) + sizeof(mNextId) + sizeof(mTime) + count * rowSize);
+}
+
+void ProjectilePool::Render(SpriteBatch& batch, const SDL_FRect& view) {
+    const float alpha = batch.GetInterpolation();
+    for (std::size_t i = 0; i < mCount; ++i) {
+        SDL_FRect rect = {mPrevX[i] + (mX[i] - mPrevX[i]) * alpha,
+                          mPrevY[i] + (mY[i] - mPrevY[i]) * alpha,
+                          mW[i], mH[i]};
+        if (rect.x >= view.x + view.w || rect.x + rect.w <= view.x ||
+            rect.y >= view.y + view.h || rect.y + rect.h <= view.y) {
+            continue;
+        }
+
+        if (mSprite.texture) {
+            batch.Draw(mSprite.texture.get(), mSprite.source, rect, RenderLayer::Projectiles);
+        } else {
+            batch.Fill(rect, SDL_Color{255, 255, 0, 255}, RenderLayer::Projectiles); // Bright yellow
+        }
+    }
+}
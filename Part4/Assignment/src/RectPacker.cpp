@@ -0,0 +1,56 @@
+#include "../include/RectPacker.hpp"
+#include <algorithm>
+#include <numeric>
+
+RectPacker::RectPacker(int pageWidth, int pageHeight, int padding)
+    : mPageWidth(pageWidth), mPageHeight(pageHeight), mPadding(padding) {}
+
+std::vector<RectPacker::Placement> RectPacker::Pack(const std::vector<SDL_Rect>& sizes) {
+    std::vector<Placement> placements(sizes.size());
+
+    std::vector<std::size_t> order(sizes.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        return sizes[a].h > sizes[b].h;
+    });
+
+    int page = 0;
+    int cursorX = mPadding;
+    int shelfY = mPadding;
+    int shelfHeight = 0;
+    bool pageUsed = false;
+
+    for (std::size_t index : order) {
+        const int w = sizes[index].w;
+        const int h = sizes[index].h;
+
+        if (w + 2 * mPadding > mPageWidth || h + 2 * mPadding > mPageHeight) {
+            continue; // Can never fit; leave page at -1
+        }
+
+        // Row full: open a new shelf below the current one
+        if (cursorX + w + mPadding > mPageWidth) {
+            shelfY += shelfHeight + mPadding;
+            cursorX = mPadding;
+            shelfHeight = 0;
+        }
+
+        // Page full: start a fresh page
+        if (shelfY + h + mPadding > mPageHeight) {
+            ++page;
+            cursorX = mPadding;
+            shelfY = mPadding;
+            shelfHeight = 0;
+        }
+
+        placements[index].page = page;
+        placements[index].rect = SDL_Rect{cursorX, shelfY, w, h};
+        pageUsed = true;
+
+        cursorX += w + mPadding;
+        shelfHeight = std::max(shelfHeight, h);
+    }
+
+    mPageCount = pageUsed ? page + 1 : 0;
+    return placements;
+}
@@ -0,0 +1,160 @@
+#include "../include/Replay.hpp"
+#include "../include/Log.hpp"
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+constexpr char ReplayMagic[4] = {'S', 'I', 'R', 'P'};
+constexpr std::uint16_t ReplayVersion = 1;
+
+struct ReplayHeader {
+    char magic[4];
+    std::uint16_t version;
+    std::uint16_t headerSize;
+    std::uint32_t tickCount;
+    std::uint32_t inputCount;
+    std::uint32_t checksumCount;
+    ReplaySettings settings;
+};
+
+static_assert(std::is_trivially_copyable_v<ReplayHeader>);
+
+} // namespace
+
+void StateHash::Add(const void* data, std::size_t size) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < size; ++i) {
+        value ^= bytes[i];
+        value *= 1099511628211ull;
+    }
+}
+
+void Replay::BeginRecording(const ReplaySettings& settings) {
+    mMode = Mode::Recording;
+    mSettings = settings;
+    mInputs.clear();
+    mChecksums.clear();
+    mButtons = 0;
+}
+
+void Replay::RecordInput(std::uint32_t tick, std::uint8_t buttons) {
+    if (mInputs.empty() || buttons != mButtons) {
+        mInputs.push_back({tick, buttons, {}});
+        mButtons = buttons;
+    }
+}
+
+bool Replay::Save(const std::string& filePath, std::uint32_t tickCount) const {
+    ReplayHeader header{};
+    std::memcpy(header.magic, ReplayMagic, sizeof(ReplayMagic));
+    header.version = ReplayVersion;
+    header.headerSize = sizeof(ReplayHeader);
+    header.tickCount = tickCount;
+    header.inputCount = static_cast<std::uint32_t>(mInputs.size());
+    header.checksumCount = static_cast<std::uint32_t>(mChecksums.size());
+    header.settings = mSettings;
+
+    FILE* file = std::fopen(filePath.c_str(), "wb");
+    if (!file) {
+        LOG_ERROR(Input, "Failed to create replay %s", filePath.c_str());
+        return false;
+    }
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+    ok = ok && std::fwrite(mInputs.data(), sizeof(Input), mInputs.size(), file) == mInputs.size();
+    ok = ok && std::fwrite(mChecksums.data(), sizeof(Hash), mChecksums.size(), file) == mChecksums.size();
+    ok = std::fclose(file) == 0 && ok;
+
+    if (!ok) {
+        LOG_ERROR(Input, "Failed to write replay %s", filePath.c_str());
+        return false;
+    }
+    LOG_INFO(Input, "Saved replay %s: %u ticks, %zu input changes, %zu checksums",
+             filePath.c_str(), tickCount, mInputs.size(), mChecksums.size());
+    return true;
+}
+
+bool Replay::Load(const std::string& filePath) {
+    FILE* file = std::fopen(filePath.c_str(), "rb");
+    if (!file) {
+        LOG_ERROR(Input, "Failed to open replay %s", filePath.c_str());
+        return false;
+    }
+
+    std::fseek(file, 0, SEEK_END);
+    const long fileSize = std::ftell(file);
+    std::fseek(file, 0, SEEK_SET);
+
+    ReplayHeader header{};
+    bool ok = fileSize > 0 && std::fread(&header, sizeof(header), 1, file) == 1 &&
+              std::memcmp(header.magic, ReplayMagic, sizeof(ReplayMagic)) == 0 &&
+              header.version == ReplayVersion && header.headerSize == sizeof(ReplayHeader);
+    // The counts must account for exactly the rest of the file before they size anything
+    ok = ok && sizeof(ReplayHeader) + std::uint64_t{header.inputCount} * sizeof(Input) +
+                   std::uint64_t{header.checksumCount} * sizeof(Hash) == static_cast<std::uint64_t>(fileSize);
+    if (ok) {
+        mInputs.resize(header.inputCount);
+        mChecksums.resize(header.checksumCount);
+        ok = std::fread(mInputs.data(), sizeof(Input), mInputs.size(), file) == mInputs.size() &&
+             std::fread(mChecksums.data(), sizeof(Hash), mChecksums.size(), file) == mChecksums.size();
+    }
+    std::fclose(file);
+
+    // Playback walks both lists forward, so their ticks must only ever go up
+    for (std::size_t i = 0; ok && i < mInputs.size(); ++i) {
+        ok = i == 0 || mInputs[i].tick > mInputs[i - 1].tick;
+    }
+    for (std::size_t i = 0; ok && i < mChecksums.size(); ++i) {
+        ok = mChecksums[i].tick <= header.tickCount && (i == 0 || mChecksums[i].tick > mChecksums[i - 1].tick);
+    }
+
+    if (!ok || header.settings.checksumInterval == 0 || header.settings.simulationRate <= 0.0f ||
+        std::memchr(header.settings.level, '\0', sizeof(header.settings.level)) == nullptr) {
+        LOG_ERROR(Input, "%s is not a valid replay", filePath.c_str());
+        mInputs.clear();
+        mChecksums.clear();
+        return false;
+    }
+
+    mMode = Mode::Playing;
+    mSettings = header.settings;
+    mTickCount = header.tickCount;
+    mNextInput = 0;
+    mNextChecksum = 0;
+    mButtons = 0;
+    mChecksumsMatched = 0;
+    mDiverged = false;
+    return true;
+}
+
+std::uint8_t Replay::GetInput(std::uint32_t tick) {
+    while (mNextInput < mInputs.size() && mInputs[mNextInput].tick <= tick) {
+        mButtons = mInputs[mNextInput].buttons;
+        ++mNextInput;
+    }
+    return mButtons;
+}
+
+void Replay::Checksum(std::uint32_t tick, std::uint64_t value) {
+    if (mMode == Mode::Recording) {
+        mChecksums.push_back({tick, 0, value});
+        return;
+    }
+    if (mMode != Mode::Playing || mDiverged) return;
+
+    while (mNextChecksum < mChecksums.size() && mChecksums[mNextChecksum].tick < tick) {
+        ++mNextChecksum;
+    }
+    if (mNextChecksum == mChecksums.size() || mChecksums[mNextChecksum].tick != tick) return;
+
+    const Hash& recorded = mChecksums[mNextChecksum++];
+    if (recorded.value == value) {
+        ++mChecksumsMatched;
+        return;
+    }
+
+    mDiverged = true;
+    mDivergedTick = tick;
+    mExpected = recorded.value;
+    mActual = value;
+}
@@ -1,5 +1,6 @@
 #include "../include/ResourceManager.hpp"
-#include <iostream>
+#include "../include/RectPacker.hpp"
+#include "../include/Log.hpp"
 
 ResourceManager* ResourceManager::mInstance = nullptr;
 
@@ -18,7 +19,7 @@ std::shared_ptr<SDL_Texture> ResourceManager::LoadTexture(SDL_Renderer* renderer
 
     SDL_Surface* surface = SDL_LoadBMP(filePath.c_str());
     if (!surface) {
-        std::cerr << "Failed to load surface: " << SDL_GetError() << std::endl;
+        LOG_ERROR(Resource, "Failed to load surface %s: %s", filePath.c_str(), SDL_GetError());
         return nullptr;
     }
 
@@ -26,7 +27,7 @@ std::shared_ptr<SDL_Texture> ResourceManager::LoadTexture(SDL_Renderer* renderer
     SDL_FreeSurface(surface);
 
     if (!texture) {
-        std::cerr << "Failed to create texture: " << SDL_GetError() << std::endl;
+        LOG_ERROR(Resource, "Failed to create texture: %s", SDL_GetError());
         return nullptr;
     }
 
@@ -34,3 +35,222 @@ std::shared_ptr<SDL_Texture> ResourceManager::LoadTexture(SDL_Renderer* renderer
     mTextures[filePath] = sharedTexture;
     return sharedTexture;
 }
+
+int ResourceManager::BuildAtlas(SDL_Renderer* renderer, const std::vector<std::string>& filePaths, int pageSize) {
+    // Load everything as 32-bit RGBA so pages can be blitted into directly
+    std::vector<SDL_Surface*> surfaces;
+    std::vector<std::string> paths;
+    std::vector<SDL_Rect> sizes;
+    for (const std::string& filePath : filePaths) {
+        SDL_Surface* loaded = SDL_LoadBMP(filePath.c_str());
+        if (!loaded) {
+            LOG_ERROR(Resource, "Failed to load surface %s: %s", filePath.c_str(), SDL_GetError());
+            continue;
+        }
+        SDL_Surface* surface = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0);
+        SDL_FreeSurface(loaded);
+        if (!surface) {
+            LOG_ERROR(Resource, "Failed to convert surface: %s", SDL_GetError());
+            continue;
+        }
+        surfaces.push_back(surface);
+        paths.push_back(filePath);
+        sizes.push_back(SDL_Rect{0, 0, surface->w, surface->h});
+    }
+
+    RectPacker packer(pageSize, pageSize);
+    std::vector<RectPacker::Placement> placements = packer.Pack(sizes);
+
+    std::vector<SDL_Surface*> pages(packer.GetPageCount(), nullptr);
+    for (auto& page : pages) {
+        page = SDL_CreateRGBSurfaceWithFormat(0, pageSize, pageSize, 32, SDL_PIXELFORMAT_RGBA32);
+    }
+
+    for (std::size_t i = 0; i < surfaces.size(); ++i) {
+        const RectPacker::Placement& placement = placements[i];
+        if (placement.page < 0) {
+            LOG_WARN(Resource, "Image too large for atlas page: %s", paths[i].c_str());
+            continue;
+        }
+        if (!pages[placement.page]) continue;
+
+        // Copy the pixels as-is rather than blending them onto the empty page
+        SDL_SetSurfaceBlendMode(surfaces[i], SDL_BLENDMODE_NONE);
+        SDL_Rect destination = placement.rect;
+        SDL_BlitSurface(surfaces[i], nullptr, pages[placement.page], &destination);
+    }
+
+    std::vector<std::shared_ptr<SDL_Texture>> textures(pages.size());
+    for (std::size_t p = 0; p < pages.size(); ++p) {
+        if (!pages[p]) continue;
+        SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, pages[p]);
+        SDL_FreeSurface(pages[p]);
+        if (!texture) {
+            LOG_ERROR(Resource, "Failed to create atlas texture: %s", SDL_GetError());
+            continue;
+        }
+        textures[p] = std::shared_ptr<SDL_Texture>(texture, SDL_DestroyTexture);
+    }
+
+    for (std::size_t i = 0; i < surfaces.size(); ++i) {
+        const RectPacker::Placement& placement = placements[i];
+        if (placement.page >= 0 && textures[placement.page]) {
+            mRegions[paths[i]] = AtlasRegion{textures[placement.page], placement.rect};
+        }
+        SDL_FreeSurface(surfaces[i]);
+    }
+
+    return packer.GetPageCount();
+}
+
+void ResourceManager::UnloadTextures() {
+    mTextures.clear();
+    mRegions.clear();
+}
+
+AtlasRegion ResourceManager::LoadRegion(SDL_Renderer* renderer, std::string filePath) {
+    if (mHeadless) return AtlasRegion{};
+
+    auto it = mRegions.find(filePath);
+    if (it != mRegions.end()) {
+        return it->second;
+    }
+
+    AtlasRegion region;
+    region.texture = LoadTexture(renderer, filePath);
+    if (region.texture) {
+        SDL_QueryTexture(region.texture.get(), nullptr, nullptr, &region.source.w, &region.source.h);
+        mRegions[filePath] = region;
+    }
+    return region;
+}
+
+TextureHandle ResourceManager::LoadTextureAsync(std::string filePath) {
+    if (mHeadless) return nullptr;
+
+    auto region = mRegions.find(filePath);
+    if (region != mRegions.end()) {
+        auto handle = std::make_shared<TextureRequest>();
+        handle->region = region->second;
+        handle->ready = true;
+        return handle;
+    }
+
+    auto pending = mPending.find(filePath);
+    if (pending != mPending.end()) {
+        return pending->second;
+    }
+
+    auto handle = std::make_shared<TextureRequest>();
+    mPending[filePath] = handle;
+
+    if (mLoaders.empty()) {
+        StartLoaders();
+    }
+    {
+        std::lock_guard<std::mutex> lock(mLoaderMutex);
+        mLoadQueue.push_back(filePath);
+    }
+    mLoaderWake.notify_one();
+    return handle;
+}
+
+int ResourceManager::ProcessUploads(SDL_Renderer* renderer, int budget) {
+    int completed = 0;
+    while (completed < budget) {
+        DecodedImage image;
+        {
+            std::lock_guard<std::mutex> lock(mLoaderMutex);
+            if (mDecoded.empty()) break;
+            image = std::move(mDecoded.front());
+            mDecoded.pop_front();
+        }
+
+        auto pending = mPending.find(image.filePath);
+        if (pending == mPending.end()) {
+            SDL_FreeSurface(image.surface);
+            continue;
+        }
+        TextureHandle handle = pending->second;
+        mPending.erase(pending);
+
+        SDL_Texture* texture = nullptr;
+        if (image.surface) {
+            texture = SDL_CreateTextureFromSurface(renderer, image.surface);
+            SDL_FreeSurface(image.surface);
+            if (!texture) image.error = SDL_GetError();
+        }
+
+        if (!texture) {
+            LOG_ERROR(Resource, "Failed to load texture %s: %s", image.filePath.c_str(), image.error.c_str());
+            handle->failed = true;
+        } else {
+            std::shared_ptr<SDL_Texture> sharedTexture(texture, SDL_DestroyTexture);
+            mTextures[image.filePath] = sharedTexture;
+
+            handle->region.texture = sharedTexture;
+            SDL_QueryTexture(texture, nullptr, nullptr, &handle->region.source.w, &handle->region.source.h);
+            mRegions[image.filePath] = handle->region;
+        }
+        handle->ready = !handle->failed;
+        ++completed;
+    }
+    return completed;
+}
+
+void ResourceManager::StartLoaders() {
+    unsigned count = std::thread::hardware_concurrency();
+    count = count > 2 ? count - 1 : 1;
+    if (count > 4) count = 4; // Disk-bound; more threads don't help
+
+    mStopLoaders = false;
+    for (unsigned i = 0; i < count; ++i) {
+        mLoaders.emplace_back(&ResourceManager::LoaderThread, this);
+    }
+}
+
+void ResourceManager::StopLoaders() {
+    {
+        std::lock_guard<std::mutex> lock(mLoaderMutex);
+        mStopLoaders = true;
+        mLoadQueue.clear();
+    }
+    mLoaderWake.notify_all();
+
+    for (auto& loader : mLoaders) {
+        loader.join();
+    }
+    mLoaders.clear();
+
+    for (auto& image : mDecoded) {
+        if (image.surface) SDL_FreeSurface(image.surface);
+    }
+    mDecoded.clear();
+    mPending.clear();
+}
+
+void ResourceManager::LoaderThread() {
+    for (;;) {
+        std::string filePath;
+        {
+            std::unique_lock<std::mutex> lock(mLoaderMutex);
+            mLoaderWake.wait(lock, [this] { return mStopLoaders || !mLoadQueue.empty(); });
+            if (mStopLoaders) return;
+            filePath = mLoadQueue.front();
+            mLoadQueue.pop_front();
+        }
+
+        // File I/O and pixel conversion happen here, off the main thread.
+        // A null surface reports the failure back through ProcessUploads().
+        SDL_Surface* surface = SDL_LoadBMP(filePath.c_str());
+        if (surface) {
+            SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0);
+            SDL_FreeSurface(surface);
+            surface = converted;
+        }
+        std::string error = surface ? std::string() : SDL_GetError();
+
+        std::lock_guard<std::mutex> lock(mLoaderMutex);
+        mDecoded.push_back(DecodedImage{filePath, surface, std::move(error)});
+    }
+}
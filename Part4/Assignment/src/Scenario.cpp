@@ -0,0 +1,94 @@
+#include "../include/Scenario.hpp"
+#include "../include/Log.hpp"
+#include "../include/Level.hpp"
+#include <cstdlib>
+#include <fstream>
+
+namespace {
+
+std::string Trim(const std::string& text) {
+    const char* whitespace = " \t\r\n";
+    std::size_t begin = text.find_first_not_of(whitespace);
+    if (begin == std::string::npos) return "";
+    std::size_t end = text.find_last_not_of(whitespace);
+    return text.substr(begin, end - begin + 1);
+}
+
+bool ParseNumber(const std::string& text, float& value) {
+    char* end = nullptr;
+    value = std::strtof(text.c_str(), &end);
+    return end != text.c_str() && *end == '\0' && value >= 0.0f;
+}
+
+} // namespace
+
+bool ApplyScenarioSetting(Scenario& scenario, const std::string& setting) {
+    std::size_t equals = setting.find('=');
+    if (equals == std::string::npos) {
+        LOG_ERROR(Core, "Scenario setting '%s' is not key=value", setting.c_str());
+        return false;
+    }
+
+    const std::string key = Trim(setting.substr(0, equals));
+    if (key == "level") {
+        scenario.level = Trim(setting.substr(equals + 1));
+        if (scenario.level.empty()) {
+            LOG_ERROR(Core, "Scenario setting 'level' needs a file name");
+            return false;
+        }
+        return true;
+    }
+
+    float value = 0.0f;
+    if (!ParseNumber(Trim(setting.substr(equals + 1)), value)) {
+        LOG_ERROR(Core, "Scenario setting '%s' needs a non-negative number", setting.c_str());
+        return false;
+    }
+
+    if (key == "rows") scenario.rows = static_cast<int>(value);
+    else if (key == "columns") scenario.columns = static_cast<int>(value);
+    else if (key == "waves") scenario.waves = static_cast<int>(value);
+    else if (key == "ticks") scenario.ticks = static_cast<int>(value);
+    else if (key == "enemy_fire_rate") scenario.enemyFireRate = value;
+    else if (key == "player_fire_interval") scenario.playerFireInterval = value;
+    else {
+        LOG_ERROR(Core, "Unknown scenario setting '%s'", key.c_str());
+        return false;
+    }
+
+    if (scenario.rows < 1 || scenario.columns < 1 || scenario.waves < 1 || scenario.ticks < 1) {
+        LOG_ERROR(Core, "Scenario setting '%s' must be at least 1", key.c_str());
+        return false;
+    }
+    if (static_cast<std::size_t>(scenario.rows) * static_cast<std::size_t>(scenario.columns) > LevelMaxWaveSlots) {
+        LOG_ERROR(Core, "Scenario waves can have at most %zu enemies", LevelMaxWaveSlots);
+        return false;
+    }
+    if (scenario.enemyFireRate <= 0.0f) {
+        LOG_ERROR(Core, "Scenario setting '%s' must be greater than 0", key.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool LoadScenario(Scenario& scenario, const std::string& filePath) {
+    std::ifstream file(filePath);
+    if (!file) {
+        LOG_ERROR(Core, "Failed to open scenario %s", filePath.c_str());
+        return false;
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        line = Trim(line.substr(0, line.find('#')));
+        if (line.empty()) continue;
+
+        if (!ApplyScenarioSetting(scenario, line)) {
+            LOG_ERROR(Core, "  at %s:%d", filePath.c_str(), lineNumber);
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,75 @@
+#include "../include/Snapshot.hpp"
+#include "../include/Log.hpp"
+#include <cstring>
+
+namespace {
+
+constexpr char SnapshotMagic[4] = {'S', 'I', 'S', 'S'};
+constexpr std::uint16_t SnapshotVersion = 2;
+
+struct SnapshotHeader {
+    char magic[4];
+    std::uint16_t version;
+    std::uint16_t headerSize;
+    std::uint32_t tick;  // simulation steps run when it was captured
+    std::uint32_t size;  // whole snapshot, header included
+};
+
+static_assert(std::is_trivially_copyable_v<SnapshotHeader>);
+
+} // namespace
+
+SnapshotWriter::SnapshotWriter(std::vector<std::byte>& buffer, std::uint32_t tick) : mBuffer(buffer) {
+    SnapshotHeader header{};
+    std::memcpy(header.magic, SnapshotMagic, sizeof(SnapshotMagic));
+    header.version = SnapshotVersion;
+    header.headerSize = sizeof(SnapshotHeader);
+    header.tick = tick;
+
+    mBuffer.clear();
+    WriteBytes(&header, sizeof(header));
+}
+
+void SnapshotWriter::WriteBytes(const void* data, std::size_t size) {
+    const auto* bytes = static_cast<const std::byte*>(data);
+    mBuffer.insert(mBuffer.end(), bytes, bytes + size);
+}
+
+void SnapshotWriter::Finish() {
+    const auto size = static_cast<std::uint32_t>(mBuffer.size());
+    std::memcpy(mBuffer.data() + offsetof(SnapshotHeader, size), &size, sizeof(size));
+}
+
+SnapshotReader::SnapshotReader(std::span<const std::byte> data) : mData(data) {
+    SnapshotHeader header{};
+    mFailed = !ReadBytes(&header, sizeof(header)) ||
+              std::memcmp(header.magic, SnapshotMagic, sizeof(SnapshotMagic)) != 0 ||
+              header.version != SnapshotVersion || header.headerSize != sizeof(SnapshotHeader) ||
+              header.size != data.size();
+    if (mFailed) {
+        LOG_ERROR(Core, "Not a valid world snapshot (%zu bytes)", data.size());
+        return;
+    }
+    mTick = header.tick;
+}
+
+bool SnapshotReader::ReadBytes(void* data, std::size_t size) {
+    if (mFailed || size > mData.size() - mOffset) {
+        mFailed = true;
+        return false;
+    }
+    if (size > 0) {
+        std::memcpy(data, mData.data() + mOffset, size);
+    }
+    mOffset += size;
+    return true;
+}
+
+bool SnapshotReader::Skip(std::size_t size) {
+    if (mFailed || size > mData.size() - mOffset) {
+        mFailed = true;
+        return false;
+    }
+    mOffset += size;
+    return true;
+}
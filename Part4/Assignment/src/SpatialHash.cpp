@@ -0,0 +1,96 @@
+#include "../include/SpatialHash.hpp"
+#include <algorithm>
+#include <cmath>
+
+SpatialHash::SpatialHash(float cellSize)
+    : mCellSize(cellSize), mInvCellSize(1.0f / cellSize) {}
+
+int SpatialHash::CellCoord(float v) const {
+    return static_cast<int>(std::floor(v * mInvCellSize));
+}
+
+std::uint32_t SpatialHash::CellHash(int cx, int cy) {
+    // Large primes from Teschner et al., "Optimized Spatial Hashing for Collision Detection".
+    return (static_cast<std::uint32_t>(cx) * 73856093u) ^ (static_cast<std::uint32_t>(cy) * 19349663u);
+}
+
+void SpatialHash::Clear() {
+    mEntries.clear();
+    mBuilt = false;
+}
+
+void SpatialHash::Insert(std::uint32_t id, const SDL_FRect& rect) {
+    const int x0 = CellCoord(rect.x);
+    const int y0 = CellCoord(rect.y);
+    const int x1 = CellCoord(rect.x + rect.w);
+    const int y1 = CellCoord(rect.y + rect.h);
+
+    for (int cy = y0; cy <= y1; ++cy) {
+        for (int cx = x0; cx <= x1; ++cx) {
+            mEntries.push_back({CellHash(cx, cy), id});
+        }
+    }
+
+    if (id >= mQueryStamp.size()) {
+        mQueryStamp.resize(id + 1, 0);
+    }
+    mBuilt = false;
+}
+
+void SpatialHash::Build() {
+    // About one bucket per entry keeps unrelated cells from sharing buckets.
+    std::uint32_t bucketCount = 64;
+    while (bucketCount < mEntries.size()) {
+        bucketCount <<= 1;
+    }
+    mBucketMask = bucketCount - 1;
+
+    mBucketStart.assign(bucketCount + 1, 0);
+    for (const Entry& entry : mEntries) {
+        ++mBucketStart[(entry.hash & mBucketMask) + 1];
+    }
+    for (std::uint32_t i = 0; i < bucketCount; ++i) {
+        mBucketStart[i + 1] += mBucketStart[i];
+    }
+
+    mSortedIds.resize(mEntries.size());
+    mCursor.assign(mBucketStart.begin(), mBucketStart.end() - 1);
+    for (const Entry& entry : mEntries) {
+        mSortedIds[mCursor[entry.hash & mBucketMask]++] = entry.id;
+    }
+
+    mBuilt = true;
+}
+
+void SpatialHash::Query(const SDL_FRect& rect, std::vector<std::uint32_t>& out) {
+    if (!mBuilt) Build();
+    if (mEntries.empty()) return;
+
+    const int x0 = CellCoord(rect.x);
+    const int y0 = CellCoord(rect.y);
+    const int x1 = CellCoord(rect.x + rect.w);
+    const int y1 = CellCoord(rect.y + rect.h);
+
+    // Stamp 0 means "never reported", so skip it on wrap-around.
+    if (++mCurrentStamp == 0) {
+        std::fill(mQueryStamp.begin(), mQueryStamp.end(), 0);
+        mCurrentStamp = 1;
+    }
+
+    const std::size_t first = out.size();
+    for (int cy = y0; cy <= y1; ++cy) {
+        for (int cx = x0; cx <= x1; ++cx) {
+            const std::uint32_t bucket = CellHash(cx, cy) & mBucketMask;
+            for (std::uint32_t i = mBucketStart[bucket]; i < mBucketStart[bucket + 1]; ++i) {
+                const std::uint32_t id = mSortedIds[i];
+                if (mQueryStamp[id] != mCurrentStamp) {
+                    mQueryStamp[id] = mCurrentStamp;
+                    out.push_back(id);
+                }
+            }
+        }
+    }
+
+    // Callers resolve "first hit wins" in id order, same as a linear scan would.
+    std::sort(out.begin() + first, out.end());
+}
@@ -0,0 +1,111 @@
+#include "../include/SpriteBatch.hpp"
+#include <algorithm>
+
+namespace {
+
+const SDL_Color White{255, 255, 255, 255};
+
+} // namespace
+
+SpriteBatch::SpriteBatch(SDL_Renderer* renderer) : mRenderer(renderer) {}
+
+void SpriteBatch::Begin(float interpolation) {
+    mCommands.clear();
+    mInterpolation = interpolation;
+    mTranslation = {0.0f, 0.0f};
+    mScale = 1.0f;
+}
+
+void SpriteBatch::Draw(SDL_Texture* texture, const SDL_FRect& dst, RenderLayer layer) {
+    Queue(texture, nullptr, dst, White, layer);
+}
+
+void SpriteBatch::Draw(SDL_Texture* texture, const SDL_Rect& src, const SDL_FRect& dst, RenderLayer layer) {
+    Queue(texture, &src, dst, White, layer);
+}
+
+void SpriteBatch::Fill(const SDL_FRect& dst, SDL_Color color, RenderLayer layer) {
+    Queue(nullptr, nullptr, dst, color, layer);
+}
+
+void SpriteBatch::Queue(SDL_Texture* texture, const SDL_Rect* src, const SDL_FRect& dst, SDL_Color color, RenderLayer layer) {
+    Command command;
+    command.layer = layer;
+    command.texture = texture;
+    command.order = static_cast<std::uint32_t>(mCommands.size());
+    command.hasSource = src != nullptr;
+    command.src = src ? *src : SDL_Rect{0, 0, 0, 0};
+    command.dst = {(dst.x + mTranslation.x) * mScale, (dst.y + mTranslation.y) * mScale, dst.w * mScale, dst.h * mScale};
+    command.color = color;
+    mCommands.push_back(command);
+}
+
+void SpriteBatch::Flush() {
+    mDrawCalls = 0;
+    if (mCommands.empty()) return;
+
+    std::sort(mCommands.begin(), mCommands.end(), [](const Command& a, const Command& b) {
+        if (a.layer != b.layer) return a.layer < b.layer;
+        if (a.texture != b.texture) return std::less<SDL_Texture*>()(a.texture, b.texture);
+        return a.order < b.order;
+    });
+
+    mVertices.clear();
+    mIndices.clear();
+
+    SDL_Texture* current = mCommands.front().texture;
+    float invW = 1.0f;
+    float invH = 1.0f;
+    auto lookUpSize = [&](SDL_Texture* texture) {
+        int w = 1, h = 1;
+        if (texture) SDL_QueryTexture(texture, nullptr, nullptr, &w, &h);
+        invW = 1.0f / static_cast<float>(w > 0 ? w : 1);
+        invH = 1.0f / static_cast<float>(h > 0 ? h : 1);
+    };
+    lookUpSize(current);
+
+    for (const Command& command : mCommands) {
+        if (command.texture != current) {
+            Submit(current);
+            current = command.texture;
+            lookUpSize(current);
+        }
+
+        float u0 = 0.0f, v0 = 0.0f, u1 = 1.0f, v1 = 1.0f;
+        if (command.hasSource) {
+            u0 = command.src.x * invW;
+            v0 = command.src.y * invH;
+            u1 = (command.src.x + command.src.w) * invW;
+            v1 = (command.src.y + command.src.h) * invH;
+        }
+
+        const SDL_FRect& d = command.dst;
+        const int base = static_cast<int>(mVertices.size());
+        mVertices.push_back({{d.x, d.y}, command.color, {u0, v0}});
+        mVertices.push_back({{d.x + d.w, d.y}, command.color, {u1, v0}});
+        mVertices.push_back({{d.x + d.w, d.y + d.h}, command.color, {u1, v1}});
+        mVertices.push_back({{d.x, d.y + d.h}, command.color, {u0, v1}});
+
+        mIndices.push_back(base);
+        mIndices.push_back(base + 1);
+        mIndices.push_back(base + 2);
+        mIndices.push_back(base);
+        mIndices.push_back(base + 2);
+        mIndices.push_back(base + 3);
+    }
+    Submit(current);
+
+    mCommands.clear();
+}
+
+void SpriteBatch::Submit(SDL_Texture* texture) {
+    if (mVertices.empty()) return;
+
+    SDL_RenderGeometry(mRenderer, texture,
+                       mVertices.data(), static_cast<int>(mVertices.size()),
+                       mIndices.data(), static_cast<int>(mIndices.size()));
+    ++mDrawCalls;
+
+    mVertices.clear();
+    mIndices.clear();
+}
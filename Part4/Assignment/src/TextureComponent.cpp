@@ -6,80 +6,97 @@ TextureComponent::TextureComponent() {}
 TextureComponent::~TextureComponent() {}
 
 void TextureComponent::CreateTextureComponent(SDL_Renderer* renderer, std::string filePath, float x, float y) {
-    mTexture = ResourceManager::Instance().LoadTexture(renderer, filePath);
+    mTexture = std::make_shared<TextureRequest>();
+    mTexture->region = ResourceManager::Instance().LoadRegion(renderer, filePath);
+    mTexture->ready = mTexture->region.texture != nullptr;
+    mTexture->failed = !mTexture->ready;
     
     // Instead of setting the position here, we'll set it on the transform component
     // when the game entity is fully initialized
 }
 
+void TextureComponent::CreateTextureComponentAsync(std::string filePath) {
+    mTexture = ResourceManager::Instance().LoadTextureAsync(filePath);
+}
+
 ComponentType TextureComponent::GetType() {
-    return ComponentType::TextureComponent;
+    return ComponentTypeOf<TextureComponent>;
 }
 
-void TextureComponent::Render(SDL_Renderer* renderer) {
-    if (!mTexture || !mGameEntity) return;
+void TextureComponent::Render(SpriteBatch& batch) {
+    GameEntity* entity = GetGameEntity();
+    if (!mTexture || !entity) return;
     
     // Get the transform component from the game entity
-    auto transform = mGameEntity->GetTransform();
-    if (!transform) return;
+    if (!entity->HasComponent<TransformComponent>()) return;
     
-    // Use the transform's rectangle for rendering
-    SDL_FRect rect = transform->GetRectangle();
+    // Draw where the entity is between the last two simulation steps
+    SDL_FRect rect = entity->GetTransform().GetInterpolatedRectangle(batch.GetInterpolation());
     
-    if (mTexture) {
-        SDL_RenderCopyF(renderer, mTexture.get(), nullptr, &rect);
+    if (mTexture->ready) {
+        batch.Draw(mTexture->region.texture.get(), mTexture->region.source, rect);
+    } else if (mTexture->failed) {
+        batch.Fill(rect, SDL_Color{255, 0, 0, 255});
     } else {
-        SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
-        SDL_RenderFillRectF(renderer, &rect);
+        // Still loading
+        batch.Fill(rect, SDL_Color{64, 64, 64, 255});
     }
 }
 
 // These methods now delegate to the transform component
 
 void TextureComponent::Move(float x, float y) {
-    if (!mGameEntity) return;
-    auto transform = mGameEntity->GetTransform();
+    GameEntity* entity = GetGameEntity();
+    if (!entity) return;
+    auto transform = entity->TryGetComponent<TransformComponent>();
     if (transform) transform->Move(x, y);
 }
 
 void TextureComponent::SetX(float x) {
-    if (!mGameEntity) return;
-    auto transform = mGameEntity->GetTransform();
+    GameEntity* entity = GetGameEntity();
+    if (!entity) return;
+    auto transform = entity->TryGetComponent<TransformComponent>();
     if (transform) transform->SetX(x);
 }
 
 void TextureComponent::SetY(float y) {
-    if (!mGameEntity) return;
-    auto transform = mGameEntity->GetTransform();
+    GameEntity* entity = GetGameEntity();
+    if (!entity) return;
+    auto transform = entity->TryGetComponent<TransformComponent>();
     if (transform) transform->SetY(y);
 }
 
 float TextureComponent::GetX() const {
-    if (!mGameEntity) return 0.0f;
-    auto transform = mGameEntity->GetTransform();
+    GameEntity* entity = GetGameEntity();
+    if (!entity) return 0.0f;
+    auto transform = entity->TryGetComponent<TransformComponent>();
     return transform ? transform->GetX() : 0.0f;
 }
 
 float TextureComponent::GetY() const {
-    if (!mGameEntity) return 0.0f;
-    auto transform = mGameEntity->GetTransform();
+    GameEntity* entity = GetGameEntity();
+    if (!entity) return 0.0f;
+    auto transform = entity->TryGetComponent<TransformComponent>();
     return transform ? transform->GetY() : 0.0f;
 }
 
 void TextureComponent::SetW(int w) {
-    if (!mGameEntity) return;
-    auto transform = mGameEntity->GetTransform();
+    GameEntity* entity = GetGameEntity();
+    if (!entity) return;
+    auto transform = entity->TryGetComponent<TransformComponent>();
     if (transform) transform->SetW(static_cast<float>(w));
 }
 
 void TextureComponent::SetH(int h) {
-    if (!mGameEntity) return;
-    auto transform = mGameEntity->GetTransform();
+    GameEntity* entity = GetGameEntity();
+    if (!entity) return;
+    auto transform = entity->TryGetComponent<TransformComponent>();
     if (transform) transform->SetH(static_cast<float>(h));
 }
 
 SDL_FRect TextureComponent::getRectangle() {
-    if (!mGameEntity) return {0.0f, 0.0f, 0.0f, 0.0f};
-    auto transform = mGameEntity->GetTransform();
+    GameEntity* entity = GetGameEntity();
+    if (!entity) return {0.0f, 0.0f, 0.0f, 0.0f};
+    auto transform = entity->TryGetComponent<TransformComponent>();
     return transform ? transform->GetRectangle() : SDL_FRect{0.0f, 0.0f, 0.0f, 0.0f};
 }
\ No newline at end of file
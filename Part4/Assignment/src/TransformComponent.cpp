@@ -1,11 +1,10 @@
 #include "../include/TransformComponent.hpp"
-#include <iostream>
+#include "../include/Log.hpp"
 
 TransformComponent::TransformComponent() {
     // Initialize with reasonable default values
     mRectangle = {0.0f, 0.0f, 40.0f, 40.0f};
-    std::cout << "TransformComponent created with default size: " 
-              << mRectangle.w << "x" << mRectangle.h << std::endl;
+    LOG_TRACE(Entity, "TransformComponent created with default size: %.0fx%.0f", mRectangle.w, mRectangle.h);
 }
 
 TransformComponent::~TransformComponent() {}
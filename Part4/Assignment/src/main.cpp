@@ -4,8 +4,22 @@
 int main(int argc, char* argv[]) {
     Application app(argc, argv);
     app.StartUp(argv);
-    app.Loop(60.0f);
+
+    int exitCode = 0;
+    if (app.IsReplaying()) {
+        exitCode = app.RunReplay() ? 0 : 1;
+    } else if (app.IsCheckingSnapshots()) {
+        exitCode = app.RunSnapshotCheck() ? 0 : 1;
+    } else if (app.IsNetBenchmarking()) {
+        exitCode = app.RunNetBench() ? 0 : 1;
+    } else if (app.IsHeadless() && app.IsServing()) {
+        app.RunServer();
+    } else if (app.IsHeadless()) {
+        app.RunScenario();
+    } else {
+        app.Loop(60.0f);
+    }
     app.ShutDown();
 
-    return 0;
+    return exitCode;
 }
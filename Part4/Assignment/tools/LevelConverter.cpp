@@ -0,0 +1,292 @@
+// LevelConverter.cpp
+//
+// Turns a text level description into the binary .level format the game maps at
+// start-up (see include/Level.hpp). The text format is one statement per line,
+// `#` starts a comment:
+//
+//   world = 800,600               optional, before any prefab: the play area the
+//                                 camera scrolls over (default: one 800x600 screen,
+//                                 at most 8000 a side)
+//
+//   prefab alien                  starts a prefab; the settings below belong to it
+//     texture = Assets/Alien.bmp
+//     size = 40,40
+//     fire_interval_ms = 1000,4000
+//
+//   wave                          starts a wave
+//     prefab = alien
+//     grid = 8,3                  columns,rows
+//     origin = 60,60
+//     spacing = 80,60
+//     fire_rate = 1
+//     ticks = 0                   steps until the next wave; 0 waits for a clear
+//     slots = 0,0 2,0 4,0         optional, may repeat; without it every slot is filled
+//
+// Build and run from Part4/Assignment:
+//   g++ -std=c++20 -Iinclude tools/LevelConverter.cpp -o level_converter
+//   ./level_converter levels/default.txt levels/default.level
+#include "../include/Level.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct NamedPrefab {
+    std::string name;
+    LevelPrefab prefab{};
+};
+
+struct ParsedWave {
+    std::string prefabName;
+    LevelWave wave{};
+    std::vector<LevelSlot> slots;
+};
+
+std::string Trim(const std::string& text) {
+    const char* whitespace = " \t\r\n";
+    std::size_t begin = text.find_first_not_of(whitespace);
+    if (begin == std::string::npos) return "";
+    std::size_t end = text.find_last_not_of(whitespace);
+    return text.substr(begin, end - begin + 1);
+}
+
+bool ParsePair(const std::string& text, float& a, float& b) {
+    char extra;
+    return std::sscanf(text.c_str(), "%f , %f %c", &a, &b, &extra) == 2;
+}
+
+bool ParseFloat(const std::string& text, float& value) {
+    char extra;
+    return std::sscanf(text.c_str(), "%f %c", &value, &extra) == 1;
+}
+
+class Converter {
+    public:
+        bool Parse(const std::string& filePath) {
+            std::ifstream file(filePath);
+            if (!file) {
+                std::fprintf(stderr, "Failed to open %s\n", filePath.c_str());
+                return false;
+            }
+
+            std::string line;
+            int lineNumber = 0;
+            while (std::getline(file, line)) {
+                ++lineNumber;
+                line = Trim(line.substr(0, line.find('#')));
+                if (line.empty()) continue;
+
+                if (!ParseLine(line)) {
+                    std::fprintf(stderr, "  at %s:%d: %s\n", filePath.c_str(), lineNumber, line.c_str());
+                    return false;
+                }
+            }
+            return Resolve();
+        }
+
+        bool Write(const std::string& filePath) const {
+            LevelHeader header{};
+            std::memcpy(header.magic, LevelMagic, sizeof(LevelMagic));
+            header.version = LevelVersion;
+            header.headerSize = sizeof(LevelHeader);
+            header.prefabCount = static_cast<std::uint32_t>(mPrefabs.size());
+            header.waveCount = static_cast<std::uint32_t>(mWaves.size());
+            header.prefabOffset = sizeof(LevelHeader);
+            header.waveOffset = header.prefabOffset + header.prefabCount * sizeof(LevelPrefab);
+            header.slotOffset = header.waveOffset + header.waveCount * sizeof(LevelWave);
+            header.worldWidth = mWorldWidth;
+            header.worldHeight = mWorldHeight;
+
+            std::vector<LevelWave> waves;
+            std::vector<LevelSlot> slots;
+            for (const ParsedWave& parsed : mWaves) {
+                LevelWave wave = parsed.wave;
+                wave.firstSlot = static_cast<std::uint32_t>(slots.size());
+                wave.slotCount = static_cast<std::uint32_t>(parsed.slots.size());
+                slots.insert(slots.end(), parsed.slots.begin(), parsed.slots.end());
+                waves.push_back(wave);
+            }
+            header.slotCount = static_cast<std::uint32_t>(slots.size());
+
+            std::ofstream file(filePath, std::ios::binary);
+            if (!file) {
+                std::fprintf(stderr, "Failed to create %s\n", filePath.c_str());
+                return false;
+            }
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            for (const NamedPrefab& named : mPrefabs) {
+                file.write(reinterpret_cast<const char*>(&named.prefab), sizeof(LevelPrefab));
+            }
+            file.write(reinterpret_cast<const char*>(waves.data()), waves.size() * sizeof(LevelWave));
+            file.write(reinterpret_cast<const char*>(slots.data()), slots.size() * sizeof(LevelSlot));
+            return static_cast<bool>(file);
+        }
+
+        std::size_t GetPrefabCount() const { return mPrefabs.size(); }
+        std::size_t GetWaveCount() const { return mWaves.size(); }
+
+    private:
+        bool ParseLine(const std::string& line) {
+            if (line.rfind("prefab ", 0) == 0 && line.find('=') == std::string::npos) {
+                NamedPrefab named;
+                named.name = Trim(line.substr(7));
+                named.prefab.width = 40.0f;
+                named.prefab.height = 40.0f;
+                named.prefab.minFireIntervalMs = 1000.0f;
+                named.prefab.maxFireIntervalMs = 4000.0f;
+                mPrefabs.push_back(named);
+                mInWave = false;
+                return true;
+            }
+            if (line == "wave") {
+                ParsedWave parsed;
+                parsed.wave.originX = 60.0f;
+                parsed.wave.originY = 60.0f;
+                parsed.wave.spacingX = 80.0f;
+                parsed.wave.spacingY = 60.0f;
+                parsed.wave.fireRate = 1.0f;
+                mWaves.push_back(parsed);
+                mInWave = true;
+                return true;
+            }
+
+            std::size_t equals = line.find('=');
+            if (equals == std::string::npos) {
+                std::fprintf(stderr, "Expected 'prefab NAME', 'wave' or key = value\n");
+                return false;
+            }
+            const std::string key = Trim(line.substr(0, equals));
+            const std::string value = Trim(line.substr(equals + 1));
+
+            if (key == "world" && mPrefabs.empty() && mWaves.empty()) {
+                return ParsePair(value, mWorldWidth, mWorldHeight) && IsValidWorldSize(mWorldWidth) &&
+                       IsValidWorldSize(mWorldHeight);
+            }
+            if (mInWave) return ParseWaveSetting(mWaves.back(), key, value);
+            if (!mPrefabs.empty()) return ParsePrefabSetting(mPrefabs.back().prefab, key, value);
+
+            std::fprintf(stderr, "Setting outside of any prefab or wave\n");
+            return false;
+        }
+
+        bool ParsePrefabSetting(LevelPrefab& prefab, const std::string& key, const std::string& value) {
+            if (key == "texture") {
+                if (value.size() >= sizeof(prefab.texture)) {
+                    std::fprintf(stderr, "Texture path longer than %zu characters\n", sizeof(prefab.texture) - 1);
+                    return false;
+                }
+                std::memset(prefab.texture, 0, sizeof(prefab.texture));
+                std::memcpy(prefab.texture, value.data(), value.size());
+                return true;
+            }
+            if (key == "size") return ParsePair(value, prefab.width, prefab.height);
+            if (key == "fire_interval_ms") return ParsePair(value, prefab.minFireIntervalMs, prefab.maxFireIntervalMs);
+
+            std::fprintf(stderr, "Unknown prefab setting '%s'\n", key.c_str());
+            return false;
+        }
+
+        bool ParseWaveSetting(ParsedWave& parsed, const std::string& key, const std::string& value) {
+            LevelWave& wave = parsed.wave;
+            if (key == "prefab") {
+                parsed.prefabName = value;
+                return true;
+            }
+            if (key == "grid") {
+                float columns, rows;
+                if (!ParsePair(value, columns, rows) || columns < 1 || rows < 1 || columns > 65535 || rows > 65535 ||
+                    columns * rows > static_cast<float>(LevelMaxWaveSlots)) return false;
+                wave.columns = static_cast<std::uint16_t>(columns);
+                wave.rows = static_cast<std::uint16_t>(rows);
+                return true;
+            }
+            if (key == "origin") return ParsePair(value, wave.originX, wave.originY);
+            if (key == "spacing") return ParsePair(value, wave.spacingX, wave.spacingY);
+            if (key == "fire_rate") return ParseFloat(value, wave.fireRate);
+            if (key == "ticks") {
+                float ticks;
+                if (!ParseFloat(value, ticks) || ticks < 0) return false;
+                wave.ticks = static_cast<std::uint32_t>(ticks);
+                return true;
+            }
+            if (key == "slots") {
+                std::istringstream stream(value);
+                std::string pair;
+                while (stream >> pair) {
+                    float column, row;
+                    if (!ParsePair(pair, column, row) || column < 0 || row < 0) return false;
+                    parsed.slots.push_back({static_cast<std::uint16_t>(column), static_cast<std::uint16_t>(row)});
+                }
+                return true;
+            }
+
+            std::fprintf(stderr, "Unknown wave setting '%s'\n", key.c_str());
+            return false;
+        }
+
+        // Turns prefab names into indices and checks what the loader would reject
+        bool Resolve() {
+            for (const NamedPrefab& named : mPrefabs) {
+                const LevelPrefab& prefab = named.prefab;
+                if (prefab.texture[0] == '\0') {
+                    std::fprintf(stderr, "Prefab '%s' has no texture\n", named.name.c_str());
+                    return false;
+                }
+                if (!(prefab.width > 0.0f && prefab.height > 0.0f) ||
+                    !(prefab.minFireIntervalMs >= 0.0f && prefab.maxFireIntervalMs > prefab.minFireIntervalMs)) {
+                    std::fprintf(stderr, "Prefab '%s' needs a positive size and min < max fire interval\n", named.name.c_str());
+                    return false;
+                }
+            }
+
+            for (std::size_t i = 0; i < mWaves.size(); ++i) {
+                ParsedWave& parsed = mWaves[i];
+                std::size_t prefab = 0;
+                while (prefab < mPrefabs.size() && mPrefabs[prefab].name != parsed.prefabName) ++prefab;
+                if (prefab == mPrefabs.size()) {
+                    std::fprintf(stderr, "Wave %zu uses unknown prefab '%s'\n", i, parsed.prefabName.c_str());
+                    return false;
+                }
+                parsed.wave.prefab = static_cast<std::uint32_t>(prefab);
+
+                if (parsed.wave.columns == 0 || parsed.wave.fireRate <= 0.0f) {
+                    std::fprintf(stderr, "Wave %zu needs a grid and a fire_rate above 0\n", i);
+                    return false;
+                }
+                for (const LevelSlot& slot : parsed.slots) {
+                    if (slot.column >= parsed.wave.columns || slot.row >= parsed.wave.rows) {
+                        std::fprintf(stderr, "Wave %zu has slot %u,%u outside its grid\n", i, slot.column, slot.row);
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        std::vector<NamedPrefab> mPrefabs;
+        std::vector<ParsedWave> mWaves;
+        float mWorldWidth{LevelDefaultWorldWidth};
+        float mWorldHeight{LevelDefaultWorldHeight};
+        bool mInWave = false;
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::fprintf(stderr, "usage: %s input.txt output.level\n", argv[0]);
+        return 1;
+    }
+
+    Converter converter;
+    if (!converter.Parse(argv[1]) || !converter.Write(argv[2])) {
+        return 1;
+    }
+
+    std::printf("Wrote %s: %zu prefabs, %zu waves\n", argv[2], converter.GetPrefabCount(), converter.GetWaveCount());
+    return 0;
+}